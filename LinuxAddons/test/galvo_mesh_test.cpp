@@ -0,0 +1,139 @@
+/**
+ * galvo_mesh_test.cpp - Galvo calibration mesh
+ *
+ * get_offset() must be the bilinear blend of the surrounding cell: a mesh
+ * holding a bilinear function gives that function back everywhere, off the
+ * mesh too, and a mesh of random offsets gives the grid values at the grid
+ * points and the mean of the corners at the middle of a cell.
+ *
+ * walk_next() must follow get_offset() along random lines that cross cell
+ * boundaries and the edge of the mesh, however many segments they have.
+ *
+ * Reported: the time per segment on this host for walk_next() and for a
+ * get_offset() per segment, over the same lines.
+ */
+
+#include <stdio.h>
+#include <math.h>
+
+#ifndef GALVO_CALIBRATION
+  #define GALVO_CALIBRATION // For the mesh settings in Configuration.h
+#endif
+
+#include "galvo_mesh.cpp"
+
+#define RANDOM_SEED 88172645UL
+#include "test_util.h"
+
+static float x_function(float x, float y) { return 0.5 + 0.01 * x - 0.02 * y + 0.0003 * x * y; }
+static float y_function(float x, float y) { return -1.0 - 0.015 * x + 0.005 * y - 0.0002 * x * y; }
+
+static void test_bilinear() {
+  gmesh.reset();
+  for (int iy = 0; iy < MESH_NUM_Y_POINTS; iy++)
+    for (int ix = 0; ix < MESH_NUM_X_POINTS; ix++)
+      gmesh.set_offset(ix, iy, x_function(gmesh.get_x(ix), gmesh.get_y(iy)), y_function(gmesh.get_x(ix), gmesh.get_y(iy)));
+
+  float worst = 0;
+  for (int n = 0; n < 100000; n++) {
+    float x = random_float(MESH_MIN_X - 20, MESH_MAX_X + 20),
+          y = random_float(MESH_MIN_Y - 20, MESH_MAX_Y + 20),
+          offset[2];
+    gmesh.get_offset(x, y, offset);
+    worst = max(worst, max(fabs(offset[X_AXIS] - x_function(x, y)), fabs(offset[Y_AXIS] - y_function(x, y))));
+  }
+  CHECK(worst < 1e-4, "a bilinear mesh is off by up to %g", worst);
+
+  for (int iy = 0; iy < MESH_NUM_Y_POINTS; iy++)
+    for (int ix = 0; ix < MESH_NUM_X_POINTS; ix++)
+      gmesh.set_offset(ix, iy, random_float(-5, 5), random_float(-5, 5));
+  for (int iy = 0; iy < MESH_NUM_Y_POINTS; iy++)
+    for (int ix = 0; ix < MESH_NUM_X_POINTS; ix++) {
+      float offset[2];
+      gmesh.get_offset(gmesh.get_x(ix), gmesh.get_y(iy), offset);
+      CHECK(fabs(offset[X_AXIS] - gmesh.x_offsets[iy][ix]) < 1e-5 && fabs(offset[Y_AXIS] - gmesh.y_offsets[iy][ix]) < 1e-5,
+            "grid point %d,%d gives %g,%g", ix, iy, offset[X_AXIS], offset[Y_AXIS]);
+      if (ix < MESH_NUM_X_POINTS - 1 && iy < MESH_NUM_Y_POINTS - 1) {
+        gmesh.get_offset(gmesh.get_x(ix) + MESH_X_DIST / 2, gmesh.get_y(iy) + MESH_Y_DIST / 2, offset);
+        float mean = (gmesh.x_offsets[iy][ix] + gmesh.x_offsets[iy][ix + 1] + gmesh.x_offsets[iy + 1][ix] + gmesh.x_offsets[iy + 1][ix + 1]) / 4;
+        CHECK(fabs(offset[X_AXIS] - mean) < 1e-5, "middle of cell %d,%d gives %g, not %g", ix, iy, offset[X_AXIS], mean);
+      }
+    }
+  printf("get_offset() is bilinear in each cell, %dx%d mesh\n", MESH_NUM_X_POINTS, MESH_NUM_Y_POINTS);
+}
+
+static void test_walk() {
+  float worst = 0;
+  long segments = 0, lines = 20000;
+  for (long n = 0; n < lines; n++) {
+    float x0 = random_float(MESH_MIN_X - 10, MESH_MAX_X + 10), y0 = random_float(MESH_MIN_Y - 10, MESH_MAX_Y + 10),
+          x1 = random_float(MESH_MIN_X - 10, MESH_MAX_X + 10), y1 = random_float(MESH_MIN_Y - 10, MESH_MAX_Y + 10);
+    // Axis-parallel lines now and then, along and across grid lines
+    if (n % 10 == 0) y1 = y0;
+    if (n % 10 == 1) x1 = x0;
+    if (n % 10 == 2) x0 = x1 = gmesh.get_x(n % MESH_NUM_X_POINTS);
+    int count = 1 + (int)random_float(0, 400);
+    float step_x = (x1 - x0) / count, step_y = (y1 - y0) / count;
+    gmesh.walk_start(x0, y0, step_x, step_y);
+    for (int s = 1; s <= count; s++) {
+      float walked[2], direct[2];
+      gmesh.walk_next(walked);
+      gmesh.get_offset(x0 + step_x * s, y0 + step_y * s, direct);
+      float error = max(fabs(walked[X_AXIS] - direct[X_AXIS]), fabs(walked[Y_AXIS] - direct[Y_AXIS]));
+      if (error > worst) worst = error;
+      CHECK(error < 1e-3, "line %ld segment %d of %d: walk %g,%g, get_offset %g,%g", n, s, count,
+            walked[X_AXIS], walked[Y_AXIS], direct[X_AXIS], direct[Y_AXIS]);
+    }
+    segments += count;
+  }
+  printf("walk_next() follows get_offset() over %ld lines, %ld segments, worst %.2g mm\n", lines, segments, worst);
+}
+
+#define SPEED_LINES 1000
+#define SPEED_SEGMENTS 200
+#define SPEED_REPEAT 20
+
+static void test_speed() {
+  static float line[SPEED_LINES][4];
+  for (int n = 0; n < SPEED_LINES; n++) {
+    line[n][0] = random_float(MESH_MIN_X, MESH_MAX_X); line[n][1] = random_float(MESH_MIN_Y, MESH_MAX_Y);
+    line[n][2] = random_float(MESH_MIN_X, MESH_MAX_X); line[n][3] = random_float(MESH_MIN_Y, MESH_MAX_Y);
+  }
+  volatile float sink = 0; // So the offsets are worked out
+
+  double start = seconds();
+  for (int r = 0; r < SPEED_REPEAT; r++)
+    for (int n = 0; n < SPEED_LINES; n++) {
+      float step_x = (line[n][2] - line[n][0]) / SPEED_SEGMENTS, step_y = (line[n][3] - line[n][1]) / SPEED_SEGMENTS, offset[2];
+      gmesh.walk_start(line[n][0], line[n][1], step_x, step_y);
+      for (int s = 1; s <= SPEED_SEGMENTS; s++) {
+        gmesh.walk_next(offset);
+        sink = sink + offset[X_AXIS] + offset[Y_AXIS];
+      }
+    }
+  double walk_time = seconds() - start;
+
+  start = seconds();
+  for (int r = 0; r < SPEED_REPEAT; r++)
+    for (int n = 0; n < SPEED_LINES; n++) {
+      float step_x = (line[n][2] - line[n][0]) / SPEED_SEGMENTS, step_y = (line[n][3] - line[n][1]) / SPEED_SEGMENTS, offset[2];
+      for (int s = 1; s <= SPEED_SEGMENTS; s++) {
+        gmesh.get_offset(line[n][0] + step_x * s, line[n][1] + step_y * s, offset);
+        sink = sink + offset[X_AXIS] + offset[Y_AXIS];
+      }
+    }
+  double direct_time = seconds() - start;
+
+  long segments = (long)SPEED_LINES * SPEED_SEGMENTS * SPEED_REPEAT;
+  printf("%-16s %12s\n", "", "ns/segment");
+  printf("%-16s %12.1f\n", "walk_next()", walk_time * 1e9 / segments);
+  printf("%-16s %12.1f\n", "get_offset()", direct_time * 1e9 / segments);
+}
+
+int main() {
+  test_bilinear();
+  test_walk();
+  test_speed();
+  if (failures) printf("%ld failures\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * gcode_parse_bench_test.cpp - Argument parsing work per line of an SLA job
+ *
+ * Every line of a job (sla_layer.gcode, or the file given) has its arguments
+ * looked up the way its handler asks for them, once with a strchr() and a
+ * strtod() for each code_seen() and code_value() as before, and once with
+ * parse_command_args() and the table. Both must find the same letters and
+ * numbers, and letters in G7 data must not be found at all.
+ *
+ * Reported per line: the bytes each way goes over, which is what it costs on
+ * the AVR, and the time on this host.
+ *
+ * usage: gcode_parse_bench_test [job.gcode]
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "gcode_parse.cpp"
+
+#include "test_util.h"
+
+#define MAX_LINES 2000
+#define REPEAT 200
+
+struct job_line {
+  char text[MAX_CMD_SIZE];
+  const char *asks; // Letters the handler looks for, in order
+  bool data;        // Ends with G7/G8 data
+};
+
+static job_line job[MAX_LINES];
+static int job_lines = 0;
+
+// The code_seen() calls each handler makes
+static const char *handler_asks(const char *command, bool &data) {
+  data = false;
+  long code = strtol(command + 1, NULL, 10);
+  if (command[0] == 'G') switch (code) {
+    case 0: case 1: return "XYZEF";        // gcode_get_destination()
+    case 4: return "PS";
+    case 7: data = true; return "IJIJPFXYXYC"; // gcode_G7()
+    case 8: data = true; return "FXYXY";
+  }
+  if (command[0] == 'M') return "S";
+  return "";
+}
+
+static bool load(const char *path) {
+  FILE *f = fopen(path, "r");
+  if (!f) { printf("can't open %s\n", path); return false; }
+  char line[256];
+  while (job_lines < MAX_LINES && fgets(line, sizeof(line), f)) {
+    char *comment = strchr(line, ';');
+    if (comment) *comment = 0;
+    size_t length = strcspn(line, "\r\n");
+    while (length && line[length - 1] == ' ') length--;
+    line[length] = 0;
+    if (!length || length >= MAX_CMD_SIZE) continue;
+    job_line &j = job[job_lines++];
+    strcpy(j.text, line);
+    j.asks = handler_asks(line, j.data);
+  }
+  fclose(f);
+  return true;
+}
+
+// The arguments, after the code, as process_next_command() finds them
+static char *arguments(char *command) {
+  while (*command && *command != ' ') command++;
+  while (*command == ' ') command++;
+  return command;
+}
+
+struct lookup { bool found; float value; };
+
+// Before: a strchr() for each letter and a strtod() for each number
+static long strchr_lookups(char *command, const job_line &j, lookup *out) {
+  char *args = arguments(command);
+  long bytes = 0;
+  if (j.data) {
+    char *d = strchr(args, 'D');
+    bytes += d ? d - args + 1 : strlen(args) + 1;
+    if (d) *d = 0;
+  }
+  for (uint8_t i = 0; j.asks[i]; i++) {
+    char *p = strchr(args, j.asks[i]);
+    bytes += p ? p - args + 1 : strlen(args) + 1;
+    out[i].found = p != NULL;
+    if (p) {
+      char *end;
+      out[i].value = strtod(p + 1, &end);
+      bytes += end - p - 1;
+    }
+  }
+  return bytes;
+}
+
+// Now: one pass, then the table
+static void table_lookups(char *command, const job_line &j, lookup *out) {
+  current_command_args = arguments(command);
+  parse_command_args();
+  if (j.data) {
+    char *d = strchr(current_command_args, 'D');
+    if (d) code_args_end(d);
+  }
+  for (uint8_t i = 0; j.asks[i]; i++) {
+    out[i].found = code_seen(j.asks[i]);
+    if (out[i].found) out[i].value = code_value();
+  }
+}
+
+// Bytes the table way goes over: the pass, the numbers read ahead and the data search
+static long table_bytes(const job_line &j) {
+  char command[MAX_CMD_SIZE];
+  strcpy(command, j.text);
+  char *args = arguments(command);
+  long bytes = strlen(args);
+  current_command_args = args;
+  parse_command_args();
+  for (uint8_t l = 0; l < 26; l++)
+    if (code_slot[l]) {
+      char *p = args + code_offset[l], *end;
+      strtod(p, &end);
+      bytes += end - p;
+    }
+  if (j.data) {
+    char *d = strchr(args, 'D');
+    if (d) bytes += d - args + 1;
+  }
+  return bytes;
+}
+
+// A letter after the D of G7/G8 data and not before it
+static bool only_in_data(const char *args, char letter) {
+  const char *d = strchr(args, 'D'), *p = strchr(args, letter);
+  return d && p > d;
+}
+
+int main(int argc, char **argv) {
+  char path[256];
+  if (argc > 1)
+    strcpy(path, argv[1]);
+  else {
+    strcpy(path, __FILE__);
+    strcpy(strrchr(path, '/') ? strrchr(path, '/') + 1 : path, "sla_layer.gcode");
+  }
+  if (!load(path)) return 1;
+
+  // Both ways find the same, and G7 data hides its letters
+  long strchr_work = 0, table_work = 0, data_lines = 0;
+  for (int i = 0; i < job_lines; i++) {
+    char before[MAX_CMD_SIZE], now[MAX_CMD_SIZE];
+    lookup want[16], got[16];
+    strcpy(before, job[i].text);
+    strcpy(now, job[i].text);
+    strchr_work += strchr_lookups(before, job[i], want);
+    table_lookups(now, job[i], got);
+    table_work += table_bytes(job[i]);
+    for (uint8_t a = 0; job[i].asks[a]; a++)
+      CHECK(want[a].found == got[a].found && (!want[a].found || want[a].value == got[a].value),
+            "line %d '%c': %s", i + 1, job[i].asks[a], job[i].text);
+    if (job[i].data) {
+      const char *args = arguments(job[i].text);
+      bool x = only_in_data(args, 'X'), f = only_in_data(args, 'F');
+      if (x || f) data_lines++;
+      strcpy(now, job[i].text);
+      table_lookups(now, job[i], got);
+      CHECK(!(x && code_seen('X')) && !(f && code_seen('F')), "line %d: a letter in the G7 data was found: %s", i + 1, job[i].text);
+    }
+  }
+
+  // Time each way over the whole job
+  double start = seconds();
+  for (int r = 0; r < REPEAT; r++)
+    for (int i = 0; i < job_lines; i++) {
+      char command[MAX_CMD_SIZE];
+      lookup out[16];
+      strcpy(command, job[i].text);
+      strchr_lookups(command, job[i], out);
+    }
+  double strchr_time = seconds() - start;
+  start = seconds();
+  for (int r = 0; r < REPEAT; r++)
+    for (int i = 0; i < job_lines; i++) {
+      char command[MAX_CMD_SIZE];
+      lookup out[16];
+      strcpy(command, job[i].text);
+      table_lookups(command, job[i], out);
+    }
+  double table_time = seconds() - start;
+
+  long lines = (long)job_lines * REPEAT;
+  printf("%d lines, %ld with X or F in G7 data\n", job_lines, data_lines);
+  printf("%-16s %12s %12s\n", "", "bytes/line", "ns/line");
+  printf("%-16s %12.1f %12.1f\n", "strchr, strtod", (double)strchr_work / job_lines, strchr_time * 1e9 / lines);
+  printf("%-16s %12.1f %12.1f\n", "table", (double)table_work / job_lines, table_time * 1e9 / lines);
+  if (failures) printf("%ld failures\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * gcode_parse_test.cpp - G-code number and argument parsing
+ *
+ * code_read_float() has to give the same float as strtod() did, bit for
+ * bit, for everything a host may send. Random numbers of up to 8 + 8 digits
+ * with signs, spaces and trailing letters are checked against strtof() (a
+ * float strtod(), as on the AVR), then a few whole commands go through
+ * parse_command_args() and code_seen().
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "gcode_parse.cpp"
+
+#define RANDOM_SEED 12345
+#include "test_util.h"
+
+static void test_numbers(long count) {
+  char text[64], number[64];
+  for (long n = 0; n < count; n++) {
+    char *p = text;
+    for (uint8_t i = random_next(3); i--;) *p++ = random_next(2) ? ' ' : '\t';
+    char *start = p;
+    switch (random_next(3)) { case 1: *p++ = '-'; break; case 2: *p++ = '+'; break; }
+    for (uint8_t i = random_next(9); i--;) *p++ = '0' + random_next(10);
+    uint8_t fraction = random_next(9);
+    if (fraction || random_next(2)) {
+      *p++ = '.';
+      while (fraction--) *p++ = '0' + random_next(10);
+    }
+    size_t length = p - start;
+    switch (random_next(3)) { case 1: strcpy(p, "E5"); break; case 2: strcpy(p, " Y1"); break; default: *p = 0; }
+
+    // What strtod() would have read, without the trailing letters
+    memcpy(number, start, length);
+    number[length] = 0;
+    float want = strtof(number, NULL), got = code_read_float(text);
+    CHECK(!memcmp(&want, &got, sizeof(float)), "code_read_float(\"%s\") = %.9g, strtod() %.9g", text, got, want);
+  }
+  printf("%ld numbers checked against strtod()\n", count);
+}
+
+// Parse args like process_next_command() does, for a command without data
+static char args[MAX_CMD_SIZE];
+static void parse(const char *text) {
+  strcpy(args, text);
+  current_command_args = args;
+  parse_command_args();
+}
+
+static void test_args() {
+  parse("X10 Y-2.5 F3000");
+  CHECK(code_seen('X') && code_value() == 10, "X10");
+  CHECK(code_seen('Y') && code_value() == -2.5f, "Y-2.5");
+  CHECK(code_seen('F') && code_value_long() == 3000, "F3000");
+  CHECK(!code_seen('Z'), "no Z");
+
+  // A space or tab between a letter and its number
+  parse("X 10 Y\t-2.5 S 255");
+  CHECK(code_seen('X') && code_has_value() && code_value() == 10, "X 10");
+  CHECK(code_seen('Y') && code_has_value() && code_value() == -2.5f, "Y<tab>-2.5");
+  CHECK(code_seen('S') && code_value_short() == 255, "S 255");
+
+  // No number at all
+  parse("X Y");
+  CHECK(code_seen('X') && !code_has_value(), "X without a number");
+
+  // An E after the digits is the E axis, not an exponent
+  parse("X1E5");
+  CHECK(code_seen('X') && code_value() == 1, "X1E5 reads X as 1");
+
+  // G7 data (base64) is cut off before its letters are searched
+  parse("L12 $1 D/8XF+Fa9Xq");
+  char *data = strchr(current_command_args, 'D');
+  code_args_end(data++);
+  CHECK(!code_seen('X') && !code_seen('F'), "letters in G7 data are not parameters");
+  CHECK(code_seen('L') && code_value() == 12, "L12 before G7 data");
+  CHECK(!strcmp(data, "/8XF+Fa9Xq"), "G7 data is kept");
+
+  printf("argument parsing checked\n");
+}
+
+int main() {
+  test_numbers(2000000);
+  test_args();
+  if (failures) printf("%ld failures\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,131 @@
+/**
+ * serial_rx_test.cpp - Serial receive ring
+ *
+ * The receive interrupt and MSerial's reads are driven in a random order
+ * against a plain queue of the same capacity: every byte read must be the
+ * one expected, available() must agree, and a byte that arrives with the
+ * ring full must be counted in rx_dropped, one with the UART's overrun flag
+ * in rx_overruns. The counts stop at 0xFFFF.
+ *
+ * Then the host streams at 115200 baud while the main loop stalls for random
+ * times. A stall shorter than the ring's worth of bytes loses nothing.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "MarlinSerial.cpp"
+
+#define RANDOM_SEED 2463534242UL
+#include "test_util.h"
+
+volatile uint8_t host_UCSR0A, host_UCSR0B, host_UCSR0C, host_UBRR0H, host_UBRR0L, host_UDR0, host_SREG;
+
+// A byte arriving at the UART, as the receive interrupt sees it
+static void receive(uint8_t c, bool overrun) {
+  host_UDR0 = c;
+  host_UCSR0A = overrun ? _BV(DOR0) : 0;
+  USART0_RX_vect();
+}
+
+// What the ring should hold
+#define CAPACITY (RX_BUFFER_SIZE - 1)
+static uint8_t expected[CAPACITY];
+static int expected_head = 0, expected_count = 0;
+
+static void reset() {
+  MSerial.flush();
+  rx_overruns = rx_dropped = 0;
+  expected_head = expected_count = 0;
+}
+
+static void test_fuzz(long operations) {
+  reset();
+  long dropped = 0, overruns = 0, bytes = 0;
+  for (long n = 0; n < operations; n++) {
+    switch (random_next(10)) {
+      case 0: case 1: case 2: case 3: { // A byte arrives
+        uint8_t c = random_next(256);
+        bool overrun = random_next(50) == 0;
+        receive(c, overrun);
+        if (overrun) overruns++;
+        if (expected_count < CAPACITY) {
+          expected[(expected_head + expected_count++) % CAPACITY] = c;
+          bytes++;
+        }
+        else
+          dropped++;
+      } break;
+      case 4: case 5: case 6: case 7: { // The main loop reads one
+        int c = MSerial.read();
+        if (!expected_count)
+          CHECK(c == -1, "read() from an empty ring gave %d", c);
+        else {
+          CHECK(c == expected[expected_head], "read() gave %d, expected %d after %ld bytes", c, expected[expected_head], bytes);
+          expected_head = (expected_head + 1) % CAPACITY;
+          expected_count--;
+        }
+      } break;
+      case 8: { // A peek
+        int c = MSerial.peek();
+        CHECK(c == (expected_count ? expected[expected_head] : -1), "peek() gave %d", c);
+      } break;
+      case 9: // Now and then the ring is emptied at once
+        if (random_next(1000) == 0) {
+          MSerial.flush();
+          expected_count = 0;
+        }
+        break;
+    }
+    CHECK(MSerial.available() == expected_count, "available() %d, expected %d", MSerial.available(), expected_count);
+  }
+  CHECK(rx_dropped == min(dropped, 0xFFFFL), "rx_dropped %u, expected %ld", rx_dropped, dropped);
+  CHECK(rx_overruns == min(overruns, 0xFFFFL), "rx_overruns %u, expected %ld", rx_overruns, overruns);
+  printf("%ld operations, %ld bytes through the ring, %ld dropped, %ld overruns\n", operations, bytes, dropped, overruns);
+}
+
+static void test_saturation() {
+  reset();
+  for (long n = 0; n < 70000 + CAPACITY; n++) receive(n, true);
+  CHECK(MSerial.available() == CAPACITY, "full ring holds %d", MSerial.available());
+  CHECK(rx_dropped == 0xFFFF && rx_overruns == 0xFFFF, "counts stop at 0xFFFF: %u %u", rx_dropped, rx_overruns);
+  for (int n = 0; n < CAPACITY; n++) {
+    int c = MSerial.read();
+    CHECK(c == (uint8_t)n, "full ring byte %d gave %d", n, c);
+  }
+  printf("counts stop at 0xFFFF\n");
+}
+
+// A byte every 86.8us at 115200 baud. The main loop drains the ring, then
+// is busy for a while. Returns the bytes lost.
+static long stream(long bytes, float longest_stall_us) {
+  reset();
+  float byte_us = 10 * 1e6 / 115200, now = 0, next_poll = 0;
+  for (long n = 0; n < bytes; n++, now += byte_us) {
+    while (next_poll <= now) {
+      while (MSerial.read() >= 0) { }
+      next_poll += 50 + random_next(1000) * longest_stall_us / 1000;
+    }
+    receive(n, false);
+  }
+  return rx_dropped;
+}
+
+static void test_stalls() {
+  float ring_us = CAPACITY * 10 * 1e6 / 115200;
+  long lost = stream(200000, ring_us * 0.95);
+  CHECK(lost == 0, "%ld bytes lost with stalls up to %.0fus", lost, ring_us * 0.95);
+  long lost_long = stream(200000, ring_us * 2);
+  CHECK(lost_long > 0, "no bytes lost with stalls up to %.0fus", ring_us * 2);
+  printf("%d byte ring holds %.1fms at 115200: stalls up to %.1fms lose nothing, up to %.1fms lose %ld of 200000 bytes\n",
+         CAPACITY, ring_us / 1000, ring_us * 0.95 / 1000, ring_us * 2 / 1000, lost_long);
+}
+
+int main() {
+  test_fuzz(4000000);
+  test_saturation();
+  test_stalls();
+  if (failures) printf("%ld failures\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,206 @@
+/**
+ * serial_tx_bench_test.cpp - Main loop time spent on serial output
+ *
+ * The USART0 registers the output touches are replaced by a model of the
+ * UART at 115200 baud on a 16MHz clock: UDR0 and a shift register, each
+ * byte on the wire for 10 bit times, and the data register empty interrupt
+ * run whenever it's enabled and due. Each poll of UCSR0A or SREG costs a few
+ * cycles, so a wait in write() takes the main loop's time as it would on the
+ * AVR.
+ *
+ * A stand-in main loop runs commands as fast as their lines arrive and
+ * prints the replies a laser job gets, once with the old busy-wait write
+ * (TX_BUFFER_SIZE 0) and once with MSerial's TX ring. Reported is the time
+ * each command holds the main loop in output, next to the time its line
+ * takes to arrive. Every byte must reach the wire in order.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <avr/io.h>
+
+#define CYCLES_PER_BYTE (16000000L * 10 / 115200)
+#define POLL_CYCLES 3    // lds, sbrs, rjmp
+#define ISR_CYCLES 50    // Entry, registers, tx_udr_empty() and reti
+#define WRITE_CYCLES 20  // The ring insert around the wait
+#define BUSY_WRITE_CYCLES 4
+
+static unsigned long cycles = 0;      // The clock
+static unsigned long shift_end = 0;   // When the shift register is done
+static bool udr_full = false;         // A byte waits in UDR0 for the shifter
+static uint8_t udr_byte;
+static uint8_t wire[1 << 16];         // What went out, in order
+static long wire_bytes = 0, lost_bytes = 0;
+static bool in_isr = false;
+
+static void uart_update() {
+  while (cycles >= shift_end && udr_full) {
+    wire[wire_bytes++ & 0xFFFF] = udr_byte;
+    udr_full = false;
+    shift_end += CYCLES_PER_BYTE;
+  }
+}
+
+static bool udre() { uart_update(); return !udr_full; }
+
+static void uart_write(uint8_t c) {
+  uart_update();
+  if (udr_full) { lost_bytes++; return; }
+  if (cycles >= shift_end) {
+    wire[wire_bytes++ & 0xFFFF] = c;
+    shift_end = cycles + CYCLES_PER_BYTE;
+  }
+  else {
+    udr_full = true;
+    udr_byte = c;
+  }
+}
+
+static void service_interrupts();
+
+// A register whose reads take time and let interrupts in
+struct polled_reg {
+  uint8_t value;
+  bool is_status;
+  operator uint8_t() {
+    cycles += POLL_CYCLES;
+    service_interrupts();
+    if (is_status) value = udre() ? _BV(UDRE0) : 0;
+    return value;
+  }
+  polled_reg &operator=(uint8_t v) { value = v; return *this; }
+  polled_reg &operator|=(uint8_t v) { value |= v; return *this; }
+  polled_reg &operator&=(uint8_t v) { value &= v; return *this; }
+};
+
+struct data_reg {
+  data_reg &operator=(uint8_t c) { uart_write(c); return *this; }
+  operator uint8_t() { return 0; }
+};
+
+static polled_reg sim_UCSR0A = { 0, true }, sim_SREG = { 0, false };
+static data_reg sim_UDR0;
+
+#undef UCSR0A
+#undef SREG
+#undef UDR0
+#define UCSR0A sim_UCSR0A
+#define SREG sim_SREG
+#define UDR0 sim_UDR0
+
+#include "MarlinSerial.cpp"
+
+volatile uint8_t host_UCSR0A, host_UCSR0B, host_UCSR0C, host_UBRR0H, host_UBRR0L, host_UDR0, host_SREG;
+
+#if TX_BUFFER_SIZE == 0
+  #error "Set TX_BUFFER_SIZE in Configuration_adv.h to compare the ring with the busy-wait."
+#endif
+
+static void service_interrupts() {
+  if (in_isr || !(sim_SREG.value & _BV(SREG_I))) return;
+  in_isr = true;
+  while ((host_UCSR0B & _BV(UDRIE0)) && udre()) {
+    cycles += ISR_CYCLES;
+    USART0_UDRE_vect();
+  }
+  in_isr = false;
+}
+
+// Work for a number of cycles, with interrupts coming in when they're due
+static void run(unsigned long work) {
+  unsigned long until = cycles + work;
+  while (cycles < until) {
+    service_interrupts();
+    unsigned long next = udr_full && shift_end < until ? shift_end : until;
+    if (next <= cycles) next = cycles + 1;
+    cycles = next;
+    uart_update();
+  }
+  service_interrupts();
+}
+
+// The write() MarlinSerial had before the ring
+static void busy_wait_write(uint8_t c) {
+  while (!TEST(M_UCSRxA, M_UDREx))
+    ;
+  M_UDRx = c;
+}
+
+struct workload {
+  const char *name;
+  int line_bytes;               // Each command's line, arriving at the baud rate
+  unsigned long command_cycles; // Time to run each command
+  const char *reply;            // Sent after each command
+  int report_every;             // An M114-style report after this many commands
+};
+
+static const char report[] = "X:60.000 Y:42.100 Z:0.000 E:0.000 Count X: 60.000 Y:42.100 Z:0.000\n";
+
+static bool busy_wait;
+static unsigned long output_cycles;
+static char sent[1 << 16];
+static long sent_bytes;
+
+static void print(const char *s) {
+  unsigned long start = cycles;
+  for (; *s; s++) {
+    sent[sent_bytes++ & 0xFFFF] = *s;
+    if (busy_wait) {
+      cycles += BUSY_WRITE_CYCLES;
+      busy_wait_write(*s);
+    }
+    else {
+      cycles += WRITE_CYCLES;
+      MSerial.write(*s);
+    }
+  }
+  output_cycles += cycles - start;
+}
+
+// Runs the commands as they arrive. Returns the microseconds per command
+// the main loop spent printing.
+static float measure(const workload &w, bool busy, int commands) {
+  cycles = shift_end = wire_bytes = lost_bytes = sent_bytes = output_cycles = 0;
+  udr_full = false;
+  busy_wait = busy;
+  host_UCSR0B = 0;
+  sei();
+  unsigned long arrival = 0;
+  for (int n = 1; n <= commands; n++) {
+    arrival += w.line_bytes * CYCLES_PER_BYTE;
+    if (cycles < arrival) run(arrival - cycles); // Waiting for the line
+    run(w.command_cycles);
+    print(w.reply);
+    if (w.report_every && n % w.report_every == 0) print(report);
+  }
+  // Let the last bytes out and check them
+  run(CYCLES_PER_BYTE * (TX_BUFFER_SIZE + 3));
+  if (wire_bytes != sent_bytes || lost_bytes || memcmp(wire, sent, min(sent_bytes, 1L << 16))) {
+    printf("%s, %s: %ld bytes sent, %ld on the wire, %ld lost\n", w.name, busy ? "busy-wait" : "ring",
+           sent_bytes, wire_bytes, lost_bytes);
+    return -1;
+  }
+  return output_cycles / 16.0 / commands;
+}
+
+int main() {
+  static const workload workloads[] = {
+    { "G1, ok",          24,  4000, "ok\n", 0 },
+    { "G7 line, ok",     93, 12000, "ok\n", 0 },
+    { "G1, windowed ok", 24,  4000, "ok N1234 P15 B3 R200\n", 0 },
+    { "G1, ok, M114/20", 24,  4000, "ok\n", 20 }
+  };
+  int failures = 0;
+  printf("us per command the main loop spends printing, %d byte ring\n", TX_BUFFER_SIZE);
+  printf("%-18s %10s %10s %10s\n", "", "line in", "busy-wait", "ring");
+  for (uint8_t i = 0; i < sizeof(workloads) / sizeof(workloads[0]); i++) {
+    const workload &w = workloads[i];
+    float before = measure(w, true, 2000),
+          after = measure(w, false, 2000);
+    if (before < 0 || after < 0) { failures++; continue; }
+    printf("%-18s %10.0f %10.1f %10.1f\n", w.name, w.line_bytes * CYCLES_PER_BYTE / 16.0, before, after);
+  }
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,290 @@
+; SLA layer: contours, raster fill and a peel, as the slicer sends them
+G21
+G90
+M650 S200
+G1 F3000
+G1 X78.000 Y60.000 F2400
+G1 X78.492 Y60.969
+G1 X78.896 Y61.986
+G1 X79.175 Y63.037
+G1 X79.301 Y64.103
+G1 X79.253 Y65.159
+G1 X79.021 Y66.180
+G1 X78.608 Y67.143
+G1 X78.026 Y68.026
+G1 X77.298 Y68.814
+G1 X76.454 Y69.500 F2400
+G1 X75.530 Y70.085
+G1 X74.562 Y70.580
+G1 X73.586 Y71.002
+G1 X72.633 Y71.375
+G1 X71.728 Y71.728
+G1 X70.885 Y72.089
+G1 X70.112 Y72.487
+G1 X69.405 Y72.944
+G1 X68.751 Y73.476
+G1 X68.134 Y74.088 F2400
+G1 X67.530 Y74.778
+G1 X66.915 Y75.530
+G1 X66.265 Y76.321
+G1 X65.562 Y77.119
+G1 X64.793 Y77.887
+G1 X63.950 Y78.585
+G1 X63.037 Y79.175
+G1 X62.063 Y79.624
+G1 X61.043 Y79.905
+G1 X60.000 Y80.000 F2400
+G1 X58.957 Y79.905
+G1 X57.937 Y79.624
+G1 X56.963 Y79.175
+G1 X56.050 Y78.585
+G1 X55.207 Y77.887
+G1 X54.438 Y77.119
+G1 X53.735 Y76.321
+G1 X53.085 Y75.530
+G1 X52.470 Y74.778
+G1 X51.866 Y74.088 F2400
+G1 X51.249 Y73.476
+G1 X50.595 Y72.944
+G1 X49.888 Y72.487
+G1 X49.115 Y72.089
+G1 X48.272 Y71.728
+G1 X47.367 Y71.375
+G1 X46.414 Y71.002
+G1 X45.438 Y70.580
+G1 X44.470 Y70.085
+G1 X43.546 Y69.500 F2400
+G1 X42.702 Y68.814
+G1 X41.974 Y68.026
+G1 X41.392 Y67.143
+G1 X40.979 Y66.180
+G1 X40.747 Y65.159
+G1 X40.699 Y64.103
+G1 X40.825 Y63.037
+G1 X41.104 Y61.986
+G1 X41.508 Y60.969
+G1 X42.000 Y60.000 F2400
+G1 X42.542 Y59.085
+G1 X43.093 Y58.223
+G1 X43.618 Y57.405
+G1 X44.088 Y56.618
+G1 X44.479 Y55.841
+G1 X44.783 Y55.056
+G1 X44.999 Y54.242
+G1 X45.138 Y53.383
+G1 X45.222 Y52.470
+G1 X45.278 Y51.500 F2400
+G1 X45.338 Y50.478
+G1 X45.438 Y49.420
+G1 X45.609 Y48.346
+G1 X45.880 Y47.287
+G1 X46.272 Y46.272
+G1 X46.797 Y45.336
+G1 X47.456 Y44.510
+G1 X48.244 Y43.820
+G1 X49.144 Y43.284
+G1 X50.134 Y42.912 F2400
+G1 X51.186 Y42.702
+G1 X52.272 Y42.643
+G1 X53.364 Y42.712
+G1 X54.438 Y42.881
+G1 X55.475 Y43.113
+G1 X56.466 Y43.371
+G1 X57.405 Y43.618
+G1 X58.300 Y43.821
+G1 X59.159 Y43.954
+G1 X60.000 Y44.000 F2400
+G1 X60.841 Y43.954
+G1 X61.700 Y43.821
+G1 X62.595 Y43.618
+G1 X63.534 Y43.371
+G1 X64.525 Y43.113
+G1 X65.562 Y42.881
+G1 X66.636 Y42.712
+G1 X67.728 Y42.643
+G1 X68.814 Y42.702
+G1 X69.866 Y42.912 F2400
+G1 X70.856 Y43.284
+G1 X71.756 Y43.820
+G1 X72.544 Y44.510
+G1 X73.203 Y45.336
+G1 X73.728 Y46.272
+G1 X74.120 Y47.287
+G1 X74.391 Y48.346
+G1 X74.562 Y49.420
+G1 X74.662 Y50.478
+G1 X74.722 Y51.500 F2400
+G1 X74.778 Y52.470
+G1 X74.862 Y53.383
+G1 X75.001 Y54.242
+G1 X75.217 Y55.056
+G1 X75.521 Y55.841
+G1 X75.912 Y56.618
+G1 X76.382 Y57.405
+G1 X76.907 Y58.223
+G1 X77.458 Y59.085
+M651
+G7 X42.00 Y42.000 I1 J0 P0.1 F1800 Dyb7px9T/4///4f/rzMnr3aSukMGocq5zgLa6u4HN2c2szsL/4Pr/7Q==
+G7 X78.00 Y42.100 I-1 J0 P0.1 F1800 D9sv/9f/w6P//6/vP/7bqndmatbKfjZ+vopybnaC0q/Xe///+////4w==
+G7 X42.00 Y42.200 I1 J0 P0.1 F1800 D0P//7P/u///V0f/90Me80bq8pW5vhqJyeKHNyL/X3r///Or/6f/f7g==
+G7 D8uX4////3eH87PTFp8HGmaOWlYF4coSIm6aW3/fP4+/T6v//////7w==
+G7 X42.00 Y42.400 I1 J0 P0.1 F1800 D5///4P//+vDn2qnNuIKKc4CceHSVvYCRj+O59sn1/9jj9f//5uzv/w==
+G7 X78.00 Y42.500 I-1 J0 P0.1 F1800 D///n4f/+9uvJoJyNoY+meaZngrGjkM6Y5NLD4///7f/3////8dr/vw==
+G7 X42.00 Y42.600 I1 J0 P0.1 F1800 D+P/t4f/z1Z+TqLeTg7OQnZKYe5aRrNe/3df////a///i4v3c9cPYvw==
+G7 D3v7+7Li2q5qDibmkd7KxpJqIxM+lo63F/9z/8Pbe+vH0/9z+0LzUuQ==
+G7 X42.00 Y42.800 I1 J0 P0.1 F1800 D2MXh4ubSuruCr3mnpWiiiMeEorG47v/W/9z//////9n/v8y5uI+Ltg==
+G7 X78.00 Y42.900 I-1 J0 P0.1 F1800 D8vWlnsKpxK62pn2Ioa+5u8m0483/2//k/+r///7Y5fS8wsGel6iDiw==
+G7 X42.00 Y43.000 I1 J0 P0.1 F1800 Dudeska2wf4J4m6ednK+dvMOx4L/y////3f/////o+bWvspeJl5BtfA==
+G7 DuJq2l6F8qaWup5eAoZCs17XaxNb04v/34vfe/7/e7dCx04p2roRyeA==
+G7 X42.00 Y43.200 I1 J0 P0.1 F1800 DpoGJhI20i6mElrPEpb3StN3L0Nf///P//+v8xeTg2ry/nYmFkH12mw==
+G7 X78.00 Y43.300 I-1 J0 P0.1 F1800 DonR5Zm21iKWJhZPF4dD/4fDY//Lv/P/P6Ozd7cSuiKGMmH1kjpZ1rg==
+G7 X42.00 Y43.400 I1 J0 P0.1 F1800 DjqZ9g6ZqfJuPoc7xt+/J9fv/+OX//9//6dbgqK7OiHOptZqlebG2xw==
+G7 DZ66CcnF6j7ei0eX/yP/V///6//fP/8bz66bSjLaRdIeCfoOlsaqOzQ==
+G7 X42.00 Y43.600 I1 J0 P0.1 F1800 DiGu4wZON263Q0uP//+bb/+L/9dje9tLjucW6sX2ufotvpHCbuZPW2w==
+G7 X78.00 Y43.700 I-1 J0 P0.1 F1800 Dip+PmJLfrL774/nj/////eT95P3x2Z6jhLiqnox2mZKbmomvkMXS5Q==
+G7 X42.00 Y43.800 I1 J0 P0.1 F1800 DgJOFtLvVuu/4/97///7e9tnJ3MDAt8HAnoaXm2e1m7S8mZSc1ub/1A==
+G7 Doseb57zN/v/+/P/7+//t7fv62aqkmIOLq6WqgJ+Vq7CW1rTGvtTz/w==
+G7 X42.00 Y44.000 I1 J0 P0.1 F1800 DmsPE4d7/6Nf/////7fzl47TguNOthq6rtX9wio2nssPNya/Jx////w==
+G7 X78.00 Y44.100 I-1 J0 P0.1 F1800 D36zB9P////ro9uni/8vtseGUhIqOs2qKdLaLtbGTnKXN9v/g//f2/w==
+G7 X42.00 Y44.200 I1 J0 P0.1 F1800 Dsr7/9f/9//r//+r/17DVvJGBjq2db4SCnp2Tvo7B19vr3Mz4/+P1/w==
+G7 D2/Lr9f/3+/vc//3/vrfNuYG9fZhqf2m3hK+Ll7PZ7ObW2uv/8/L//w==
+G7 X42.00 Y44.400 I1 J0 P0.1 F1800 D0/z/////6NnDwtCrwb+OvYiYkoucc3SymLnb28Xi8f/W///6///U9w==
+G7 X78.00 Y44.500 I-1 J0 P0.1 F1800 D3P/j4fbnz//e1b250n+Sk4mKZLJzdZeSzNfY0/X/4P/x3P/r/+nr3w==
+G7 X42.00 Y44.600 I1 J0 P0.1 F1800 D////3f/c6sHAyZKDs7StjnibdXeXzpSwruL4/OLw6f////P/1uLXyQ==
+G7 D//j+59/M37qmo5iEj7B8jW6dkpnF07mz7sLV0P/3///d9+jRvcTs3g==
+G7 X42.00 Y44.800 I1 J0 P0.1 F1800 D69Xy+cPa4qt/g7q3kX9pl5mIhKS2pvnTxPX///L//97py/z446LCjw==
+G7 X78.00 Y44.900 I-1 J0 P0.1 F1800 D+f/G66ajtpylj42Zao2zn6+6ksrA5fHi0P/u/+nj///w8cCwlY/Ehw==
+G7 X42.00 Y45.000 I1 J0 P0.1 F1800 D6rjq5Lm/i4CUiXinfXaDsMivyL2+//TZ///m/+nr//D/v9aly5R2nQ==
+G7 D6a/AsYmEin5pq2qUgavRyuL32vPv//X////////Yuazv0sScrryieg==
+G7 X42.00 Y45.200 I1 J0 P0.1 F1800 D0b2Mfn6VnJJwoK63hI+mrNX6zdL//+ze4f/d383wyq+qi6W/inqNsg==
+G7 X78.00 Y45.300 I-1 J0 P0.1 F1800 Dp7SDi6ahfrGMwLqjuMurzNX75Pn///D54P/I5eXn1tOLlbG4lpOGmQ==
+G7 X42.00 Y45.400 I1 J0 P0.1 F1800 Dpbd6k45voIuMzZC75M3g//TT3Pfu/v///vLz1KCewZa/b2hqZK+YmA==
+G7 DeKiRqIKfvKDQobbV//rc4df57v/k2t3k6s2hm9CqwbegsaakiIR3hQ==
+G7 X42.00 Y45.600 I1 J0 P0.1 F1800 DbKhom4WUk5Gjo/v/3N7/8f//////3f7ZrsDeiba1apabn3GkiJeSsg==
+G7 X78.00 Y45.700 I-1 J0 P0.1 F1800 DgWp6nJuLsuLe9d/t6+D/3PD58OTW4MTRvtWcpb2soKCoaXKundS+vg==
+G7 X42.00 Y45.800 I1 J0 P0.1 F1800 Dmr3AiNKrtLG80dn/7P/t3NjU2MK6q6LZsZK1cpdxg4GFgH+JnO342A==
+G7 Dr4aVnLbM2+n+8dj/+//e//T/9+jE44yyeKSqcJChb7O/m5bgx8PxxA==
+G7 X42.00 Y46.000 I1 J0 P0.1 F1800 DwqO6qK3l/9j/7//////w/9HWwbfNmId7qK1xtJCYfq63nNOr49nu8Q==
+G7 X78.00 Y46.100 I-1 J0 P0.1 F1800 DxuHnyO7/7f/q////1vf/4O6zzc+niqighK6CeZmynsuvxdT/1+Dz/w==
+G7 X42.00 Y46.200 I1 J0 P0.1 F1800 D7+/l1+r88Pzo7uLo+NDEzMDFppJ+d4l+laJvc668rd342frK4vb//w==
+G7 Ds93/////+P/16dr87tTB5JWzlKC4eISbpql5z7/Zute79f/h3Pv/9A==
+G7 X42.00 Y46.400 I1 J0 P0.1 F1800 D1+X//+f////p//601dy5t7OLgZilc7WYeZuowdCvtcj9//////zk7g==
+G7 X78.00 Y46.500 I-1 J0 P0.1 F1800 D9v//9///7eDSv8Tc26WQoqGjiap1pZyUoru32cX3xPD/9////////w==
+G7 X42.00 Y46.600 I1 J0 P0.1 F1800 D4v/u///W0f/bt926zXpyhG+JhLR3vI2iqNbUx9n7/+v//+b/+OP/0Q==
+G7 D/+X/4P/R2OG9pcW9vHSln3ajiK6MxdeXt9f1///5/////97l9L+z8w==
+G7 X42.00 Y46.800 I1 J0 P0.1 F1800 D3v/b//rwuJ6puMmBlXKSj6OuuJWpyMje1P/O9fv//////+z/4sXeog==
+G7 X78.00 Y46.900 I-1 J0 P0.1 F1800 D/OPq3bzrn46xu6CtrWqYj3x3haPT8LX6/////+3//9/py/b/u6Wkhg==
+G7 X42.00 Y47.000 I1 J0 P0.1 F1800 D/Mmz1au1ypqXgZtojGmiusWL0OXquc79////49z////U8t/loJK5jw==
+G7 Dyvyhyol/hHiDc3Sha5K/n8SuqdzMzvL/////+dvSx8Oy9KO+qZ+8fw==
+G7 X42.00 Y47.200 I1 J0 P0.1 F1800 D5OeVq6i6oqJ5dnWZhsu6zs7h1v/y9fnh/////8vU/9LpyaetpZ20gQ==
+G7 X78.00 Y47.300 I-1 J0 P0.1 F1800 Dza1+no6KmniwbpOJyZ266e3m/9f/////8vL1/8Pj4LOtzXmhpKtvqA==
+G7 X42.00 Y47.400 I1 J0 P0.1 F1800 DsIGOnLCmhamUr7vQqrXDzMrf9f///////93gu+rOoLfNr3d6jLBolQ==
+G7 DmK+1ZnBpg7e1y9OyxNHw0P///+v73f/n3ey7qJ+RyaeqqG6wlnZ3kw==
+G7 X42.00 Y47.600 I1 J0 P0.1 F1800 Dkq6Bb6edibSZwLvEysPo/d3/3uH4///Iwr3Hk6Gjv7ifcaCOmI+okA==
+G7 X78.00 Y47.700 I-1 J0 P0.1 F1800 Dk6GVfqeVkozSu7LO4Nb//+z/5f/Q/8Xq0MKqv4bAmHiOgG6DrMKYyg==
+G7 X42.00 Y47.800 I1 J0 P0.1 F1800 Dd4mgppqYlL/x2end8f/n////4N3/vfu62sWhg42AkpuGh42DsrHNuA==
+G7 DcJSJgsPXzu/L/M3//PL//9r/4d/6vKqkxJWGg7Jub7SrlpKgo+z5zQ==
+G7 X42.00 Y48.000 I1 J0 P0.1 F1800 DvKKekqXq6Mb//P/+/+bY///S2Mq227aBiJywsGSSq6i5ipvFw9jr/w==
+G7 X78.00 Y48.100 I-1 J0 P0.1 F1800 Dh7Ck4uf7x///6d365PH/3dG+zLnUhXp8godmsLCntZq+n8q1y8Xr4A==
+G7 X42.00 Y48.200 I1 J0 P0.1 F1800 DzNzy9OLW3+X/7P//7+fT/+bRqIquqbm0p2iXb52itKrC2/fk+P/a/w==
+G7 D5cDn4///2f/o/+zW7/PK5Zupk62ipGtpaLaOwp7W16L4weDY/9j/+Q==
+G7 X42.00 Y48.400 I1 J0 P0.1 F1800 DuePW9//v6uL//+zL8fbjpcCMtX2MmK2JjI6CxrDS8vfX9ub//////w==
+G7 X78.00 Y48.500 I-1 J0 P0.1 F1800 D/////976//Hm///i78uOr4yOk62NoomQjqGNlLLvvf/1/97/////3g==
+G7 X42.00 Y48.600 I1 J0 P0.1 F1800 D//Lt////4+P//87hn8SfxL13mHFlnbXBkMvK7cLw6P//5/////j76g==
+G7 D////////77zw1dGzmbyWfJ2tlLGJfqav373Sz/bK1N36///9//D//w==
+G7 X42.00 Y48.800 I1 J0 P0.1 F1800 D//////v847Drv8F+fLCEcJiUqaK+yp+w2e3u/f/////m7v/288TX5Q==
+G7 X78.00 Y48.900 I-1 J0 P0.1 F1800 D7+Pz8f3m9a3Qp7mKqn6Ye268u8mTv+b5uvTK0f7/2///3f/BuMO00Q==
+G7 X42.00 Y49.000 I1 J0 P0.1 F1800 D///j+uyx3KGxwXx5eKamdnKDiqHa4ur//NTV///t9//x2r/S9KTWiQ==
+G7 D8tTq9MqPiJSitGucaraKkpiLpum/3cD/9///+//f8Pr/0d7FxcV+kg==
+G7 X42.00 Y49.200 I1 J0 P0.1 F1800 DwcG0wLiUdJKZq5Jzk7Ooq7+gs+Xn/+z/8f////L/yd6zz6uqkYOJiw==
+G7 X78.00 Y49.300 I-1 J0 P0.1 F1800 D6qnUurOOfpWRf5qcw8aguNrpz93/4fj//////+jz/+u5opa9frGJlQ==
+G7 X42.00 Y49.400 I1 J0 P0.1 F1800 DltCPm26Yb3qCkoeEidPG5NXTzfTf9f/r//j7+Pb/9Kivl3uelZlnnw==
+G7 DoaudunJ7iXWOwJiLxaP2yffi9+r/4P/+/9//0vLd1KezvJhncohqtA==
+G7 X42.00 Y49.600 I1 J0 P0.1 F1800 DwXOGcmiNg5uCtr7mwNL+0Pn//////////8HK2tmcv5B1sIZ6qXuLuQ==
+G7 X78.00 Y49.700 I-1 J0 P0.1 F1800 Di4VreZSYp4efua+68/3n79f//+v/99rS//K8vNeLuaJ8d7CgnYqGpw==
+G7 X42.00 Y49.800 I1 J0 P0.1 F1800 DZZKjg3R+pLKxstb00+H9//////nj/8S1pdPKi6K4inKim6WFuaaIwA==
+G7 Db4u8wZylnK+suPLb9v/x/+/k+P/p5cHLuqSrhLKWhIJsb33A0sCfwA==
+G7 X42.00 Y50.000 I1 J0 P0.1 F1800 DqKW2lbLl7v/F1+ro6v//5Nn//9PL05iQz7mme4lta6iin4W/lLW/5g==
+G7 X78.00 Y50.100 I-1 J0 P0.1 F1800 DmHy+2srxzvzT/////////9zz//mombHJmbSwmZOie5ajxZCxwenF1w==
+G7 X42.00 Y50.200 I1 J0 P0.1 F1800 Dy7vf7uTp/+v////85/Hl3v++wLiYmbuQp4KqnoOyvYvI3ue06sr/4g==
+G7 D0uTpw///3v///+/v///LxtntmbqaeZtsZbCApJaHk8Ok9Mn/0/vq/w==
+G7 X42.00 Y50.400 I1 J0 P0.1 F1800 Dz7Db1Ov//////9n/8sfd6sHZj3yPiZJ8nWm3rIuJ0a2z19jd//z/7Q==
+G7 X78.00 Y50.500 I-1 J0 P0.1 F1800 D/+D/8//b3v/q///9ua6nqdbIpah7nZaCuLKBsLfcwNfL///a9PD//w==
+G7 X42.00 Y50.600 I1 J0 P0.1 F1800 D7///////2f7//+XNprfGzn3Ae3eGlYl1tJ602+jt/9LO/+Pz///i/w==
+G7 D9fXs5P/////f4fDRvI6nnKmnk4ODloOJnI3T2Ont//Tq/+Pt//vt/w==
+G7 X42.00 Y50.800 I1 J0 P0.1 F1800 D///k8f/Y/9HW7sXHrq54p416h4eydpLXtb2s0cf9//D////i6ufGxA==
+G7 X78.00 Y50.900 I-1 J0 P0.1 F1800 D/+Dh2v/rxqq2tMt9nG+CjY1oqKPGraOg2rXG////////+f/Ox+L3yw==
+G7 X42.00 Y51.000 I1 J0 P0.1 F1800 D4P//78+7pqumk7t7lpOakKu4u5DU3MnH/+L/1f7////5////17m9kg==
+G7 D///M473ur7qHdrt4c2uqqoq/ma7m08PR2f/Y//r//+/59fTKzJqYgg==
+G7 X42.00 Y51.200 I1 J0 P0.1 F1800 Dze7cq7XUsayguYFnhGmOq5ukwLnT7OTw//L/7//44u/jv9Odz6WQmw==
+G7 X78.00 Y51.300 I-1 J0 P0.1 F1800 D//bXrdGCjZpsnHuce5Z7kKCattbO//vh7v//5P/49uSz7bWk0Xhzeg==
+G7 X42.00 Y51.400 I1 J0 P0.1 F1800 D5OSpyq99a2uMbHV8so7KyZ/A0v/c///o////2vXa0LK/p4edlXRsfQ==
+G7 D042wupqJZY1qpLWcyLfNx+Px7f///+7////fxNj847fZsZWId3CzaA==
+G7 X42.00 Y51.600 I1 J0 P0.1 F1800 Dh6u3kp2qjKG2dLnD1Mr1+/Ho////4///8//ovfnirdSdlKiTpq+jsw==
+G7 X78.00 Y51.700 I-1 J0 P0.1 F1800 Dj35vp5KohLONsKuvuOrRyvf////q/+ft9Mfd0NnNp7B6jJeJnXamsQ==
+G7 X42.00 Y51.800 I1 J0 P0.1 F1800 Df6d3ZHebsr+l4s7s4fHq0//z2//32P/V2+7AuqaalKRyp6Nxg4GvqA==
+G7 Ds5NqoqCmh7LN3P3b8uz//+v/8f/8zNTZrKHEsamynqRncbO1r7m/yQ==
+G7 X42.00 Y52.000 I1 J0 P0.1 F1800 DoH11rK/FpOCr09r9/9z//////9jK0LLmkpO7foevnmt/lK6AycPktw==
+G7 X78.00 Y52.100 I-1 J0 P0.1 F1800 DnnbIlLbDvfK73P/4//zm///t6v/h5MyRqJ2OmZyphI+GhISi2M/m9Q==
+G7 X42.00 Y52.200 I1 J0 P0.1 F1800 Dvo+1vrjk/cfy0v/i////1ezb7M62q9HKrZ+ffn5tgaiIiZ+j8vDTxw==
+G7 DyaLYwdXW/+Ln8//n/+Dmz8Dkv7fDt4p2emp4nY2KvqbPp8fM4P/m5Q==
+G7 X42.00 Y52.400 I1 J0 P0.1 F1800 DsNGu3/Hd9vP/5vP/5OD23tyrlbOLja+qbYmklnO4jqfYydf////g8g==
+G7 X78.00 Y52.500 I-1 J0 P0.1 F1800 Dtuzd4v/73f//5dT53M3Vqa21rbCsiI+SenaTfMXCoOa5y//9/9vf4A==
+G7 X42.00 Y52.600 I1 J0 P0.1 F1800 D9//W/+f////f/93tybTHkcOiho1zcYJ0fbCbx9Opz+zb2v//3v/7/w==
+G7 D3vL///Xr9///4sawsJ3JypGMdHp3hWujps3KosXzxsv/7fT6///d7w==
+G7 X42.00 Y52.800 I1 J0 P0.1 F1800 D2v//59/x/9/l37PY3J19m6CbaG+FfLKOlrqrwMrY8NfV/9////3U/w==
+G7 X78.00 Y52.900 I-1 J0 P0.1 F1800 D4fT/3///z+b5t9bKkpiVb6CveZ+etaTT2PC5v+Ho8PD////0///E5g==
+G7 X42.00 Y53.000 I1 J0 P0.1 F1800 D//////zK0dTpx618maq0ZnKin6XGqcis0PbX0Pz////f/f3X5dDm1g==
+G7 D//Lc3/+00668o6GCl3qAkLafm72w1O3Dy/P/09fx6Pn//+jrwO7dwA==
+G7 X42.00 Y53.200 I1 J0 P0.1 F1800 D4un0versu76emJqOtJSocbC4sZChtfjs//b/7P//3Pz/1LnQtK7VyQ==
+G7 X78.00 Y53.300 I-1 J0 P0.1 F1800 D/7/hueKu0ZWUrmiZqpx3pL22t8m////R///s9P/d5O//yc+i26usoA==
+G7 X42.00 Y53.400 I1 J0 P0.1 F1800 Dy8vEzZ/LnKSacYWUnJmqv7CowP/1///p/+Du+////+23xci4srmSuQ==
+G7 DsrjEgnyzsYyRsZaOk4bOoO3fxejg6Ob////////p4L+u1MevlnyBjw==
+G7 X42.00 Y53.600 I1 J0 P0.1 F1800 DmbqEs2ywgq2dnYzCpp6tws/81fPZ///r///vy//747jXm5KVdZOsbw==
+G7 X78.00 Y53.700 I-1 J0 P0.1 F1800 Dr3mxcnSNf2inxI/Bt+Cy8P///9vg///k/+Tj/9PG082YjbKAiK2qbg==
+G7 X42.00 Y53.800 I1 J0 P0.1 F1800 Dj4JqpIacmXnJppnktOTt////9eL///3szPb3s83Ez7CGlLN8c5uDmQ==
+G7 DgW6mZqCGjZ+h28Wt/8PT//H/3P//8f/r/7zk4K2omXhrepGbbquHrw==
+G7 X42.00 Y54.000 I1 J0 P0.1 F1800 DcXeUpq+DrrbWtr7//+////X/+NXk5vvl06rBkYdvd4CuqZhxdorEmg==
+G7 X78.00 Y54.100 I-1 J0 P0.1 F1800 DfrGxfaez4+fm9dvL8fH//+fi/9jX7OLl2r2DunGieZeEp63Hlp7a8w==
+G7 X42.00 Y54.200 I1 J0 P0.1 F1800 DmnmXoI7M7s3A5dvu2d//3v/q377168qrhYmpa6JxcX+AuJPX1sq5+Q==
+G7 DpH6Rl+e19///////5OD//+345qjjqoiSsqWAc36ceb+FydHIs73b0w==
+G7 X42.00 Y54.400 I1 J0 P0.1 F1800 Djr29zNjh2P/////z2N3VyMf6vdi7uqq8sn9uZ29xhraQrPDR8OLc8w==
+G7 X78.00 Y54.500 I-1 J0 P0.1 F1800 Dusyu4PHX5v/v////8+e/6Oyeu6LAn5Vmgo9wr4WHiLfR993rz//k/w==
+G7 X42.00 Y54.600 I1 J0 P0.1 F1800 Dusz/zP/0////4+7n57rP2aWgzq68fomWhJOOeIqjtvD3ysr/2///5A==
+G7 Dv8n/0+D/5Oz/3v//1+GynKWhpJ98nHCglpqUh8C3tMzp8fL/2/Pk4w==
+G7 X42.00 Y54.800 I1 J0 P0.1 F1800 D2v/8+vLg6v/YyurOrd7UnH12jmaGdZWcupWaxMHb5tf/4ffw///Z6w==
+G7 X78.00 Y54.900 I-1 J0 P0.1 F1800 D6vP///j/8cjEwNjLrql+rqOkcnKgsq+Ft57Z5Mja/f/c6fPj+v///w==
+G7 X42.00 Y55.000 I1 J0 P0.1 F1800 D9///39z/3/bJ6uS6jn2lrGyCp32vnZqVn97N8/zb3P///+bw8vXGwg==
+G7 D///25/+//+mfzIm/j6qzdZJ4nJp/s6a4qf730f/w3v//6evy6//GqQ==
+G7 X42.00 Y55.200 I1 J0 P0.1 F1800 D/9bhxOfrv57Hr7eshLR/faSHnLmrscqw7Nj2/9r//+70z9r/1PTVyw==
+G7 X78.00 Y55.300 I-1 J0 P0.1 F1800 D///vxcm615Sep353pnWwlHiPocWwsfz2++//9u79/9/S+sWvxp6tlQ==
+G7 X42.00 Y55.400 I1 J0 P0.1 F1800 D1O635cawwcB8ooSjqLOdt8ahzKr32P/76vj5////79DF/+O2uIWyrQ==
+G7 D37/XuaKyfYWrmJd3iKCotM7Jt87Y6d3Z/+z////V///ny97OrKGlkA==
+G7 X42.00 Y55.600 I1 J0 P0.1 F1800 DuNOMlKidd7WJq4KNwJi4u8HAwP///9303P/////gtq+bpY6ZcYGDeg==
+G7 X78.00 Y55.700 I-1 J0 P0.1 F1800 DsaN9dXlwb315p5uDxrvDzOf66Pnc5Pzv+d7U/77Osb+0v7OAgLKraw==
+G7 X42.00 Y55.800 I1 J0 P0.1 F1800 Dk6yfjmeBjHGqgYfUqLnl89//3v///+vX5//ZwOG5sMSws6+Qa2eDbg==
+G7 DjqyLf560g4iUq7Cru7nZ//r8/////9r/68PSp77KnYiEuISfaIGXhQ==
+G7 X42.00 Y56.000 I1 J0 P0.1 F1800 DqaeSoauVfoyR5NLj9crr//T//////v/32/ahnL6FlHxqq3RupsF+qw==
+G7 X78.00 Y56.100 I-1 J0 P0.1 F1800 DbI+drXuMtpuhq9bO/9ze/+/////h4c7e18C3jpSornNvhpmqkpbXug==
+G7 X42.00 Y56.200 I1 J0 P0.1 F1800 DoJqHhZfHouLX18Xr///u///+5fLW6K6brM2mcouzaWiPiJqcs7bL9w==
+G7 DmKOqqJ24qOb/5tXq7f/7//z8+t++v9q0hqGEkHapa66oobvFsc3b2A==
+G7 X42.00 Y56.400 I1 J0 P0.1 F1800 DfYuYvqSv1fHU/+D/4fP//+77487r2MCinZKTrXGytrSCwsnRqdDY4g==
+G7 X78.00 Y56.500 I-1 J0 P0.1 F1800 DstTJtvrB/////97r/97j/93uzqGlzHyKlpx4lXGjj6iwwOPE9///1A==
+G7 X42.00 Y56.600 I1 J0 P0.1 F1800 Dp+7c/9fi1f/p///c1uH+tee20L+NuIZ4d7SebqiL0rHpy9Dz4////w==
+G7 Drb298uTz//v4/+np/87G66PEy5CQnqZqo2imgYfRy7TV89jn////+g==
+G7 X42.00 Y56.800 I1 J0 P0.1 F1800 D0d/f///////94+L3vbmz2qyJsZB9maGetrC2qMzewe///+L/7/jk/w==
+G7 X78.00 Y56.900 I-1 J0 P0.1 F1800 D+Nf/5v/////+1vP255WOvKKvuJibtI6CvH+c5tDg4v//7//v////5g==
+G7 X42.00 Y57.000 I1 J0 P0.1 F1800 D9+bs3v/////91tXdkbDAtZSjco6GnMDHzbGe1+TG9v//2/7//P/f8g==
+G7 D3OTz8trd1d/KvZzAoIR7equqcHuljoTJx9i4/9n/4/7f5eDp3sq/2w==
+G7 X42.00 Y57.200 I1 J0 P0.1 F1800 D/+/k/9vLysDovJ2ogKKPlpiGpI+3iKaxv8bq/9f////f////w/Dkog==
+G7 X78.00 Y57.300 I-1 J0 P0.1 F1800 D//7+/8qz6NebvouffGWkpmicq5fSxtbX9v//5///8/vw/8b/287hrw==
+G7 X42.00 Y57.400 I1 J0 P0.1 F1800 D//LS/OzZso64dn6cbq2bkL26u5Cn88TL+PPk////+Nz/8cOw37qkhg==
+G7 D5Nvcu9bJwqu3i5+MmKR9e5GvnO/yyfD88vn/3///0tHHtsHV2r+Dlg==
+G7 X42.00 Y57.600 I1 J0 P0.1 F1800 D3vSyoJORsYyReXiCp46appe4vP/k0P//////897//t+z0bHEu7iGiQ==
+G7 X78.00 Y57.700 I-1 J0 P0.1 F1800 DtdeYxZ2hfXagoaeQvq6W3OH449f33///6er//+rn4+/gpKt8mYSgcw==
+G7 X42.00 Y57.800 I1 J0 P0.1 F1800 Ds77KoLOUoX2rgaCS0qjCzdL/0P/X9P/k8v//0dW6xKChyHWPbppviA==
+G7 Dp71vqZqQsKyFd8ijrL6609Lu///////Y1//zwMjboLmnc21smrOrnA==
+G4 P200
+G1 Z1.5 F120
+G1 Z-1.45 F120
+G4 P500
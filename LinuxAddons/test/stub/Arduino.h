@@ -0,0 +1,38 @@
+#pragma once
+// Just enough of the Arduino core and avr-libc headers to build Marlin
+// sources on the host for the tests in LinuxAddons/test
+#include <stdint.h>
+#include <math.h>
+#include <stdlib.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+typedef uint8_t byte; typedef bool boolean;
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define DEC 10
+#define HEX 16
+#define BIN 2
+#define OCT 8
+#define BYTE 0
+#define PI 3.1415926535897932384626433832795
+#define min(a,b) ((a)<(b)?(a):(b))
+#define max(a,b) ((a)>(b)?(a):(b))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define sq(x) ((x)*(x))
+#define square(x) ((x)*(x))
+#define lround(x) ((long)roundf(x))
+#define noInterrupts() cli()
+#define interrupts() sei()
+#define clockCyclesPerMicrosecond() (F_CPU / 1000000L)
+unsigned long millis(); unsigned long micros(); void delay(unsigned long); void delayMicroseconds(unsigned int);
+void pinMode(uint8_t,uint8_t); void digitalWrite(uint8_t,uint8_t); int digitalRead(uint8_t); void analogWrite(uint8_t,int); int analogRead(uint8_t);
+void tone(uint8_t,unsigned int,unsigned long d=0); void noTone(uint8_t);
+#define digitalPinToTimer(p) 0
+#define NOT_ON_TIMER 0
+class __FlashStringHelper;
+#define F(s) ((const __FlashStringHelper*)(s))
+#include "Print.h"
@@ -0,0 +1,17 @@
+#pragma once
+#include "Print.h"
+// The members of the Arduino class, for its size
+class LiquidCrystal : public Print {
+public:
+  LiquidCrystal(uint8_t rs, uint8_t enable, uint8_t d0, uint8_t d1, uint8_t d2, uint8_t d3);
+  void begin(uint8_t cols, uint8_t rows, uint8_t charsize = 0);
+  void clear();
+  void setCursor(uint8_t, uint8_t);
+  void createChar(uint8_t, uint8_t[]);
+  virtual size_t write(uint8_t);
+  using Print::write;
+private:
+  uint8_t _rs_pin, _rw_pin, _enable_pin, _data_pins[8];
+  uint8_t _displayfunction, _displaycontrol, _displaymode;
+  uint8_t _initialized, _numlines, _currline;
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "WString.h"
+class Print { public:
+ virtual size_t write(uint8_t)=0;
+ size_t write(const char *s){return 0;}
+ size_t write(const uint8_t*b,size_t n){return n;}
+ size_t print(const char[]); size_t print(char); size_t print(unsigned char,int=10); size_t print(int,int=10); size_t print(unsigned int,int=10); size_t print(long,int=10); size_t print(unsigned long,int=10); size_t print(double,int=2); size_t print(const String&);
+ size_t println(const char[]); size_t println(char); size_t println(unsigned char,int=10); size_t println(int,int=10); size_t println(unsigned int,int=10); size_t println(long,int=10); size_t println(unsigned long,int=10); size_t println(double,int=2); size_t println(void); size_t println(const String&);
+};
@@ -0,0 +1,9 @@
+#pragma once
+#include <stdint.h>
+#define SPI_CLOCK_DIV2 4
+#define SPI_CLOCK_DIV4 0
+#define MSBFIRST 1
+#define SPI_MODE0 0
+#define SPI_MODE1 4
+class SPIClass { public: static uint8_t transfer(uint8_t); static void begin(); static void setClockDivider(uint8_t); static void setBitOrder(uint8_t); static void setDataMode(uint8_t);};
+extern SPIClass SPI;
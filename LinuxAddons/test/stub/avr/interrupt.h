@@ -0,0 +1,7 @@
+#pragma once
+#include "io.h"
+// Interrupt handlers become plain functions the test calls
+#define ISR(vector, ...) extern "C" void vector(void); void vector(void)
+#define SIGNAL(vector) ISR(vector)
+static inline void sei() { SREG |= _BV(SREG_I); }
+static inline void cli() { SREG &= (uint8_t)~_BV(SREG_I); }
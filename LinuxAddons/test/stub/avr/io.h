@@ -0,0 +1,24 @@
+#pragma once
+#include <stdint.h>
+
+// USART0, as plain variables the test drives
+extern volatile uint8_t host_UCSR0A, host_UCSR0B, host_UCSR0C, host_UBRR0H, host_UBRR0L, host_UDR0, host_SREG;
+#define UCSR0A host_UCSR0A
+#define UCSR0B host_UCSR0B
+#define UCSR0C host_UCSR0C
+#define UBRR0H host_UBRR0H
+#define UBRR0L host_UBRR0L
+#define UDR0 host_UDR0
+#define SREG host_SREG
+#define RXC0 7
+#define TXC0 6
+#define UDRE0 5
+#define DOR0 3
+#define U2X0 1
+#define RXCIE0 7
+#define UDRIE0 5
+#define RXEN0 4
+#define TXEN0 3
+#define SREG_I 7
+#define _BV(bit) (1 << (bit))
+#define _SFR_BYTE(sfr) (sfr)
@@ -0,0 +1,26 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#ifndef PROGMEM
+  #define PROGMEM
+#endif
+#ifndef PSTR
+  #define PSTR(s) (s)
+#endif
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define pgm_read_byte_near(p) (*(const uint8_t*)(p))
+#define pgm_read_word_near(p) (*(const uint16_t*)(uintptr_t)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define pgm_read_float(p) (*(const float*)(p))
+#define strncpy_P strncpy
+#define strcpy_P strcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strstr_P strstr
+#define sprintf_P sprintf
+#define memcpy_P memcpy
+typedef char prog_char;
+#define pgm_read_float_near(p) (*(const float*)(p))
+#define pgm_read_byte_far(p) (*(const uint8_t*)(p))
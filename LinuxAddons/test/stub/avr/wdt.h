@@ -0,0 +1,5 @@
+#pragma once
+#define wdt_reset()
+#define wdt_enable(x)
+#define wdt_disable()
+#define WDTO_4S 8
@@ -0,0 +1,60 @@
+#pragma once
+// The ATmega2560 registers the firmware uses beyond the USART0 ones in
+// avr/io.h, for laser_ram_report. Declarations only: they take no RAM.
+#include <stdint.h>
+extern volatile uint8_t PINC, DDRC, PORTC, PINF, DDRF, PORTF, PINL, DDRL, PORTL;
+extern volatile uint8_t SPCR, SPSR, SPDR, MCUSR;
+extern volatile uint8_t TCCR1A, TCCR1B, TIMSK1, TIFR1;
+extern volatile uint16_t TCNT1, OCR1A, OCR1B;
+#define PINC4 4
+#define PINC5 5
+#define PINF7 7
+#define PINL0 0
+#define PINL1 1
+#define PINL3 3
+#define PINL7 7
+#define SPIE 7
+#define SPIF 7
+#define COM1A0 6
+#define COM1B0 4
+#define WGM10 0
+#define WGM11 1
+#define WGM12 3
+#define WGM13 4
+#define CS10 0
+#define OCIE1A 1
+#define OCIE1B 2
+#define OCF1B 2
+// binary.h, the patterns the LCD's custom characters use
+#define B00000 0
+#define B00001 1
+#define B00010 2
+#define B00011 3
+#define B00100 4
+#define B00101 5
+#define B00110 6
+#define B00111 7
+#define B01000 8
+#define B01001 9
+#define B01010 10
+#define B01011 11
+#define B01100 12
+#define B01101 13
+#define B01110 14
+#define B01111 15
+#define B10000 16
+#define B10001 17
+#define B10010 18
+#define B10011 19
+#define B10100 20
+#define B10101 21
+#define B10110 22
+#define B10111 23
+#define B11000 24
+#define B11001 25
+#define B11010 26
+#define B11011 27
+#define B11100 28
+#define B11101 29
+#define B11110 30
+#define B11111 31
@@ -0,0 +1,15 @@
+#pragma once
+extern "C" {
+double sin(double); double cos(double); double tan(double);
+double asin(double); double acos(double); double atan(double); double atan2(double, double);
+double sqrt(double); double fabs(double); double floor(double); double ceil(double);
+double round(double); double pow(double, double);
+double exp(double); double log(double); double log10(double); double fmod(double, double);
+double hypot(double, double);
+float sinf(float); float cosf(float); float sqrtf(float); float fabsf(float); float roundf(float);
+}
+#define NAN __builtin_nan("")
+#define INFINITY __builtin_inf()
+#define M_PI 3.14159265358979323846
+#define isnan(x) __builtin_isnan(x)
+#define isinf(x) __builtin_isinf(x)
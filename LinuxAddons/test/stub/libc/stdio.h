@@ -0,0 +1,6 @@
+#pragma once
+#include <stddef.h>
+extern "C" {
+int sprintf(char *, const char *, ...);
+int snprintf(char *, size_t, const char *, ...);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <stddef.h>
+extern "C" {
+int abs(int);
+long labs(long);
+int atoi(const char *);
+long atol(const char *);
+double atof(const char *);
+double strtod(const char *, char **);
+long strtol(const char *, char **, int);
+unsigned long strtoul(const char *, char **, int);
+void *malloc(size_t);
+void free(void *);
+char *itoa(int, char *, int);
+char *ltoa(long, char *, int);
+char *ultoa(unsigned long, char *, int);
+char *dtostrf(double, signed char, unsigned char, char *);
+long random(void);
+}
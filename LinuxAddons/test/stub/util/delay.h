@@ -0,0 +1,2 @@
+#pragma once
+static inline void _delay_ms(double){} static inline void _delay_us(double){}
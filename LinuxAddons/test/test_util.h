@@ -0,0 +1,47 @@
+/**
+ * test_util.h - What the host tests share
+ *
+ * CHECK() counts a failure and prints the first ten; main() returns
+ * non-zero if there were any. The random numbers are xorshift, so a run is
+ * the same everywhere: a test that wants its own sequence defines
+ * RANDOM_SEED before including this, or sets random_state. seconds() is a
+ * monotonic clock for timing.
+ */
+
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+static long failures = 0;
+
+#define CHECK(cond, ...) do{ if (!(cond)) { if (failures++ < 10) { printf(__VA_ARGS__); printf("\n"); } } }while(0)
+
+#ifndef RANDOM_SEED
+  #define RANDOM_SEED 88172645UL
+#endif
+
+static uint32_t random_state = RANDOM_SEED;
+
+static inline uint32_t random_u32() {
+  random_state ^= random_state << 13;
+  random_state ^= random_state >> 17;
+  random_state ^= random_state << 5;
+  return random_state;
+}
+
+// 0 to n - 1
+static inline uint32_t random_next(uint32_t n) { return random_u32() % n; }
+
+// low to high, in a million steps
+static inline float random_float(float low, float high) { return low + (high - low) * (random_u32() % 1000000) / 1000000.0; }
+
+static inline double seconds() {
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+#endif // TEST_UTIL_H
@@ -297,6 +297,19 @@
   
 #ifdef LASER
 #define MAX_STEP_FREQUENCY 10000
+  #ifdef GALVO_TIMED_MOTION
+    #define GALVO_UPDATE_TICKS (F_CPU / 8 / GALVO_UPDATE_RATE) // Timer1 ticks per galvo update
+  #endif
+  #ifdef GALVO_JUMP_MODE
+    #define GALVO_JUMP_DELAY_POINTS 4
+    #define GALVO_JUMP_MAX_DELAY 30000 // us, so the settle time fits in OCR1A
+  #endif
+  #ifdef LASER_DELAYS
+    #define LASER_MAX_DELAY 30000 // us, so a delay fits in OCR1A/OCR1B
+  #endif
+  #if defined(MUVE_Z_PEEL) || defined(BINARY_PROTOCOL)
+    #define PLANNER_DWELL // Timed pauses in the block buffer, plan_buffer_dwell()
+  #endif
 #else
 #ifdef CONFIG_STEPPERS_TOSHIBA
 #define MAX_STEP_FREQUENCY 10000 // Max step frequency for Toshiba Stepper Controllers
@@ -435,6 +448,7 @@
   #define HAS_HOME (PIN_EXISTS(HOME))
   #define HAS_KILL (PIN_EXISTS(KILL))
   #define HAS_SUICIDE (PIN_EXISTS(SUICIDE))
+  #define HAS_GALVO_LDAC (PIN_EXISTS(GALVO_LDAC))
   #define HAS_PHOTOGRAPH (PIN_EXISTS(PHOTOGRAPH))
   #define HAS_X_MIN (PIN_EXISTS(X_MIN))
   #define HAS_X_MAX (PIN_EXISTS(X_MAX))
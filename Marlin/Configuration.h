@@ -85,7 +85,9 @@ Here are some standard links for getting your machine calibrated:
 #define MULT_SCALAR 1
 // Laser control method
 // 1 : Direct PWM control
+// 3 : PWM on Timer4 (OC4A) at LASER_PWM Hz, with LASER_POWER_PIN
 #define LASER_CONTROL 1
+#define LASER_PWM 8000
 // Extruder controls laser firing
 #define LASER_EXTRUDER 
 // uncomment this to use inverted logic (high == off, low == on) for laser
@@ -98,8 +100,110 @@ Here are some standard links for getting your machine calibrated:
 // Distance from final mirror to base of reservoir.  Needs to be accurate in
 // order for calibration to be accurate
 #define LASER_RES_DISTANCE 140
-// Enables galvo calibration
-//#define GALVO_CALIBRATION
+// Correct for the tangent distortion of the galvo field, using the distance
+// above.  Moves are split into short segments that are planned in corrected
+// galvo space, so the stepper interrupt does no extra work.
+#define GALVO_FIELD_CORRECTION
+// Enables galvo field calibration (G29, M420).  The X/Y offsets measured on
+// the grid below are blended across the field as moves are segmented.
+#define GALVO_CALIBRATION
+// Time based galvo motion.  The stepper interrupt runs at a fixed rate and
+// moves the galvos along the velocity profile of the block, so one update can
+// cover many DAC steps.  Blocks with Z motion still use the step generator.
+#define GALVO_TIMED_MOTION
+// Galvo position update rate in Hz.  Must be between 50 and 40000.
+#define GALVO_UPDATE_RATE 20000
+// Galvo motion model for galvo-only moves (needs GALVO_TIMED_MOTION).  The
+// stepper jerk and acceleration limits are replaced by the mirror response:
+// a top beam angular velocity and acceleration per axis and the small-signal
+// bandwidth.  The acceleration is what the mirrors follow on a long move, the
+// top velocity over the acceleration time on the galvo's datasheet (1200
+// deg/sec in 0.5 ms here).  The mirrors trail the command by about
+// 1/(2*pi*bandwidth), so a change of velocity at a corner is limited to what
+// they make up within GALVO_CORNER_DEVIATION.  M203 still caps the speed.
+//#define GALVO_KINEMATICS
+#define GALVO_MAX_ANGULAR_VELOCITY { 1200, 1200 }            // X, Y optical degrees per second
+#define GALVO_MAX_ANGULAR_ACCELERATION { 2400000, 2400000 }  // X, Y optical degrees per second^2
+#define GALVO_BANDWIDTH 2000                                 // Hz
+#define GALVO_CORNER_DEVIATION 0.05                          // mm
+// Queue galvo DAC writes and send them from the SPI interrupt instead of
+// waiting on the SPI bus inside the stepper interrupt.  The DAC then owns the
+// SPI bus, so this can't be used with SDSUPPORT.
+#define GALVO_ASYNC_DAC
+// Load both galvo DAC channels first and then latch them together, so the
+// mirrors move as one on diagonals.  Uses GALVO_LDAC_PIN if the board has one,
+// otherwise an "update all channels" frame is sent after each pair.
+#define GALVO_DAC_LATCH
+// Laser-off XY moves jump straight to their end point instead of being
+// accelerated, then wait for the mirrors to settle.  The settle time is
+// interpolated from the jump length in this table (M656).  Delays are in
+// microseconds and must be under 30000.
+//#define GALVO_JUMP_MODE
+#define GALVO_JUMP_LENGTHS { 1, 10, 40, 140 }   // mm
+#define GALVO_JUMP_DELAYS { 100, 200, 400, 800 } // us
+// Laser delays (M657), in microseconds and under 30000.  The laser turns on
+// LASER_ON_DELAY after a marking move starts, so the mirrors are up to speed
+// first.  LASER_OFF_DELAY holds the laser on at the end of a mark before the
+// next move starts, so the mirrors catch up.  LASER_POLYGON_DELAY is waited at
+// marking corners sharper than LASER_POLYGON_ANGLE (degrees).
+//#define LASER_DELAYS
+#define LASER_ON_DELAY 0
+#define LASER_OFF_DELAY 0
+#define LASER_POLYGON_DELAY 0
+#define LASER_POLYGON_ANGLE 30
+// Raster lines (G7).  A G7 sweeps a run of pixels, sent as base64, along a
+// line at the current feedrate and sets the laser for each pixel, so an area
+// fill doesn't need a G1 per vector.  Each line gets a laser-off lead-in
+// and lead-out long enough to reach the scan speed, so every pixel is swept
+// at that speed.  With LASER_CONTROL 1 the laser fires for pixels of
+// LASER_RASTER_THRESHOLD and up.
+#define LASER_RASTER
+#define LASER_RASTER_PITCH 0.1       // mm, until set with G7 P
+#define LASER_RASTER_THRESHOLD 128
+// Pulsed firing (M655 P D).  Galvo marks fire a pulse of LASER_PULSE_DURATION
+// every 1/LASER_PPM mm instead of firing all along, so the energy per mm is
+// the same at any speed.  Pulses are spaced by galvo travel, so spacing holds
+// through acceleration.  Marks that move Z still fire continuously.
+//#define LASER_PULSED
+#define LASER_PPM 10                 // Pulses per mm
+#define LASER_PULSE_DURATION 1000    // us
+// Count laser-on time, marked and jump mm and buffer underruns per layer.
+// M663 marks the end of a layer, M664 reports the counts.
+#define LASER_LAYER_STATS
+// Laser power follows the galvo speed (M659), so the slower ends of a mark
+// don't get more energy per mm than the middle.  The intensity is the
+// ceiling, reached at the mark's nominal speed.  Needs LASER_CONTROL 3.
+//#define LASER_VELOCITY_POWER
+// Hatch fill (M660-M662).  The contours of a layer are uploaded once and the
+// hatch lines are worked out here, so they don't all go over serial.  Nested
+// contours are holes.  Each vertex takes 4 bytes of RAM (kept to 0.01mm),
+// and one byte of stack while M662 runs.
+#define LASER_HATCH
+#define HATCH_MAX_VERTICES 128
+// Polylines (G8).  A G8 marks a run of vertices sent as packed X/Y deltas in
+// galvo grid steps, a byte or two each, instead of a G1 line per vertex.
+#define LASER_POLYLINE
+// Binary motion frames (M690).  Fixed-size frames with a CRC and sequence
+// number that go straight to the planner, for hosts that need more moves per
+// second than G-code lines give.  See binary_protocol.h and
+// LinuxAddons/bin/laser_binary_send.
+//#define BINARY_PROTOCOL
+// Z peel (M652, M653).  M652 queues the peel up, the pause and the return to
+// the next layer as planner blocks and returns at once, so the next layer's
+// moves are read in while the peel runs.  The pause is a timed block rather
+// than a G4, which would wait for the buffer to empty.
+#define MUVE_Z_PEEL
+// Layer replay (M667-M669).  The moves between M667 and M668 are kept in RAM
+// and M669 plans them again, for resins that need a layer exposed more than
+// once, without the host sending it again.  Moves are kept as sent, before
+// they're cut into galvo segments: each G0/G1, polyline line and arc segment
+// is a 4 byte record, as is each change of feedrate, and an M662 hatch fill
+// takes 3 records however many lines it makes.  160 records (640 bytes) hold
+// the vector moves of LinuxAddons/test/sla_layer.gcode with room to spare.
+// A layer that needs more, or with raster lines, isn't kept, and M668 says
+// why.  There's no SD card to spill to: GALVO_ASYNC_DAC has the SPI bus.
+//#define LASER_LAYER_REPLAY
+#define LAYER_REPLAY_MOVES 160
 #endif
 // Define this to set a unique identifier for this printer, (Used by some programs to differentiate between machines)
 // You can use an online service to generate a random UUID. (eg http://www.uuidgenerator.net/version4)
@@ -423,7 +527,7 @@ const bool Z_PROBE_ENDSTOP_INVERTING = false; // set to true to invert the logic
 #define Y_MAX_POS 140
 #define Z_MAX_POS 140
 
-// Number of calibration grid points per axis.  The stepping will be MAX_LENGTH/MESH_NUM_X_POINTS
+// Number of calibration grid points per axis.  The stepping will be MAX_LENGTH/(MESH_NUM_X_POINTS - 1)
 #ifdef GALVO_CALIBRATION
 #define MESH_NUM_X_POINTS 6
 #define MESH_NUM_Y_POINTS 6
@@ -570,7 +674,7 @@ const bool Z_PROBE_ENDSTOP_INVERTING = false; // set to true to invert the logic
 
 // default settings
 #define DAC_SIZE 65536
-#define GRID_SIZE 2048 //The scaled down grid used for the dac_table in order to handle curvature compensation
+#define GRID_SIZE 2048 //The galvo step grid. Each grid step is GRID_SCALAR DAC steps
 #define GRID_SCALAR 65536/GRID_SIZE
 #define XY_STEPS_PER_UNIT GRID_SIZE/X_MAX_LENGTH //65535/X_MAX_POS/XY_GALVO_SCALAR
 #define Z_MICROSTEPS 8
@@ -404,7 +404,11 @@ const unsigned int dropsegments=5; //everything with less than this number of st
 
 // The number of linear motions that can be in the plan at any give time.
 // THE BLOCK_BUFFER_SIZE NEEDS TO BE A POWER OF 2, i.g. 8,16,32 because shifts and ors are used to do the ring-buffering.
-#ifdef SDSUPPORT
+#ifdef LASER
+  // Laser blocks are compact, and short SLA segments need the lookahead. 32 blocks take 2912 bytes;
+  // 64 don't fit in the 8K with the rest of the firmware (LinuxAddons/bin/laser_ram_report).
+  #define BLOCK_BUFFER_SIZE 32
+#elif defined(SDSUPPORT)
   #define BLOCK_BUFFER_SIZE 16   // SD,LCD,Buttons take more memory, block buffer needs to be smaller
 #else
   #define BLOCK_BUFFER_SIZE 16 // maximize block buffer
@@ -416,6 +420,20 @@ const unsigned int dropsegments=5; //everything with less than this number of st
 #define MAX_CMD_SIZE 96
 #define BUFSIZE 4
 
+// Bytes of the command queue. Commands are stored back to back, each taking
+// its length plus one, so short lines queue many more than BUFSIZE.
+#define CMD_QUEUE_SIZE (BUFSIZE * MAX_CMD_SIZE)
+
+// Bytes received from the serial port and not yet read into the command
+// buffer. A power of 2, up to 256, so the ring indexes wrap with a mask.
+#define RX_BUFFER_SIZE 256
+
+// Bytes waiting to be sent on the serial port. The UART interrupt sends them,
+// so replies don't hold up the main loop for a character time each. When the
+// ring is full, output waits for room, so nothing (no "ok") is ever lost.
+// A power of 2, up to 256, or 0 to send each byte as it's written.
+#define TX_BUFFER_SIZE 64
+
 // Bad Serial-connections can miss a received command by sending an 'ok'
 // Therefore some clients abort after 30 seconds in a timeout.
 // Some other clients start sending commands while receiving a 'wait'.
@@ -425,6 +443,14 @@ const unsigned int dropsegments=5; //everything with less than this number of st
 // Some clients will have this feature soon. This could make the NO_TIMEOUTS unnecessary.
 //#define ADVANCED_OK
 
+// M691 S1 makes every "ok" report "N<last line queued> P<free planner blocks>
+// B<free command queue slots> R<free receive bytes>". The N acknowledges every
+// line up to it, so a host can keep up to the receive ring's worth of
+// numbered lines in flight instead of waiting for each ok. A line out of
+// sequence is then dropped quietly while a resend is pending, and the receive
+// ring isn't flushed, as the host resends from the line asked for.
+//#define WINDOWED_OK
+
 // @section fwretract
 
 // Firmware based and LCD controlled retract
@@ -218,6 +218,10 @@ void ok_to_send();
   void calculate_delta(float cartesian[3]);
   void calculate_SCARA_forward_Transform(float f_scara[3]);
 #endif
+#ifdef LASER
+  void calculate_galvo(float cartesian[3]);
+  extern float galvo[3];
+#endif
 void reset_bed_level();
 void prepare_move();
 void kill(const char *);
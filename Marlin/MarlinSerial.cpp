@@ -30,19 +30,25 @@
 
 #if UART_PRESENT(SERIAL_PORT)
   ring_buffer rx_buffer  =  { { 0 }, 0, 0 };
+  volatile uint16_t rx_overruns = 0, rx_dropped = 0;
+  #if TX_BUFFER_SIZE > 0
+    tx_ring_buffer tx_buffer = { { 0 }, 0, 0 };
+  #endif
 #endif
 
 FORCE_INLINE void store_char(unsigned char c) {
-  int i = (unsigned int)(rx_buffer.head + 1) % RX_BUFFER_SIZE;
+  uint8_t h = rx_buffer.head, i = (h + 1) & RX_BUFFER_MASK;
 
   // if we should be storing the received character into the location
   // just before the tail (meaning that the head would advance to the
   // current location of the tail), we're about to overflow the buffer
   // and so we don't write the character or advance the head.
   if (i != rx_buffer.tail) {
-    rx_buffer.buffer[rx_buffer.head] = c;
+    rx_buffer.buffer[h] = c;
     rx_buffer.head = i;
   }
+  else if (rx_dropped < 0xFFFF)
+    rx_dropped++;
 }
 
 
@@ -51,11 +57,30 @@ FORCE_INLINE void store_char(unsigned char c) {
   // fixed by Mark Sproul this is on the 644/644p
   //SIGNAL(SIG_USART_RECV)
   SIGNAL(M_USARTx_RX_vect) {
+    // The overrun flag goes with the byte waiting in UDR, so check it first
+    if (TEST(M_UCSRxA, M_DORx) && rx_overruns < 0xFFFF) rx_overruns++;
     unsigned char c  =  M_UDRx;
     store_char(c);
   }
 #endif
 
+#if TX_BUFFER_SIZE > 0
+
+  // Send the next byte, and stop the interrupt once the ring is empty. The
+  // interrupt can be left on with nothing to send (see write()), so check.
+  FORCE_INLINE void tx_udr_empty() {
+    uint8_t t = tx_buffer.tail;
+    if (t != tx_buffer.head) {
+      M_UDRx = tx_buffer.buffer[t];
+      tx_buffer.tail = t = (t + 1) & TX_BUFFER_MASK;
+    }
+    if (t == tx_buffer.head) cbi(M_UCSRxB, M_UDRIEx);
+  }
+
+  ISR(M_USARTx_UDRE_vect) { tx_udr_empty(); }
+
+#endif
+
 // Constructors ////////////////////////////////////////////////////////////////
 
 MarlinSerial::MarlinSerial() { }
@@ -93,11 +118,35 @@ void MarlinSerial::begin(long baud) {
 }
 
 void MarlinSerial::end() {
+  flushTX();
   cbi(M_UCSRxB, M_RXENx);
   cbi(M_UCSRxB, M_TXENx);
   cbi(M_UCSRxB, M_RXCIEx);  
 }
 
+#if TX_BUFFER_SIZE > 0
+
+  void MarlinSerial::write(uint8_t c) {
+    uint8_t h = tx_buffer.head, i = (h + 1) & TX_BUFFER_MASK;
+
+    // Wait for room rather than lose output. With interrupts off (output from
+    // an interrupt handler, or kill()) the ring is emptied from here.
+    while (i == tx_buffer.tail)
+      if (!TEST(SREG, SREG_I) && TEST(M_UCSRxA, M_UDREx)) tx_udr_empty();
+
+    tx_buffer.buffer[h] = c;
+    tx_buffer.head = i;
+    sbi(M_UCSRxB, M_UDRIEx);
+  }
+
+  // Wait for the ring to empty
+  void MarlinSerial::flushTX(void) {
+    while (tx_buffer.head != tx_buffer.tail)
+      if (!TEST(SREG, SREG_I) && TEST(M_UCSRxA, M_UDREx)) tx_udr_empty();
+  }
+
+#endif
+
 
 int MarlinSerial::peek(void) {
   if (rx_buffer.head == rx_buffer.tail) {
@@ -113,8 +162,9 @@ int MarlinSerial::read(void) {
     return -1;
   }
   else {
-    unsigned char c = rx_buffer.buffer[rx_buffer.tail];
-    rx_buffer.tail = (unsigned int)(rx_buffer.tail + 1) % RX_BUFFER_SIZE;
+    uint8_t t = rx_buffer.tail;
+    unsigned char c = rx_buffer.buffer[t];
+    rx_buffer.tail = (t + 1) & RX_BUFFER_MASK;
     return c;
   }
 }
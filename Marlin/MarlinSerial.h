@@ -53,7 +53,10 @@
 #define M_UBRRxH SERIAL_REGNAME(UBRR,SERIAL_PORT,H)
 #define M_UBRRxL SERIAL_REGNAME(UBRR,SERIAL_PORT,L)
 #define M_RXCx SERIAL_REGNAME(RXC,SERIAL_PORT,)
+#define M_DORx SERIAL_REGNAME(DOR,SERIAL_PORT,)
 #define M_USARTx_RX_vect SERIAL_REGNAME(USART,SERIAL_PORT,_RX_vect)
+#define M_USARTx_UDRE_vect SERIAL_REGNAME(USART,SERIAL_PORT,_UDRE_vect)
+#define M_UDRIEx SERIAL_REGNAME(UDRIE,SERIAL_PORT,)
 #define M_U2Xx SERIAL_REGNAME(U2X,SERIAL_PORT,)
 
 
@@ -65,21 +68,43 @@
 
 
 #ifndef AT90USB
-// Define constants and variables for buffering incoming serial data.  We're
-// using a ring buffer (I think), in which rx_buffer_head is the index of the
-// location to which to write the next incoming character and rx_buffer_tail
-// is the index of the location from which to read.
-#define RX_BUFFER_SIZE 128
-
+// Define constants and variables for buffering incoming serial data. The
+// receive interrupt writes at head, the main loop reads from tail. The size is
+// a power of 2 (set in Configuration_adv.h), so the indexes wrap with a mask,
+// and fits a byte index, so reading one can't be torn by the interrupt.
+#ifndef RX_BUFFER_SIZE
+  #define RX_BUFFER_SIZE 128
+#endif
+#define RX_BUFFER_MASK (RX_BUFFER_SIZE - 1)
 
 struct ring_buffer {
   unsigned char buffer[RX_BUFFER_SIZE];
-  int head;
-  int tail;
+  volatile uint8_t head;
+  volatile uint8_t tail;
 };
 
+// Bytes to send, written at head by the main loop and sent from tail by the
+// data register empty interrupt.
+#ifndef TX_BUFFER_SIZE
+  #define TX_BUFFER_SIZE 0
+#endif
+#if TX_BUFFER_SIZE > 0
+  #define TX_BUFFER_MASK (TX_BUFFER_SIZE - 1)
+
+  struct tx_ring_buffer {
+    unsigned char buffer[TX_BUFFER_SIZE];
+    volatile uint8_t head;
+    volatile uint8_t tail;
+  };
+#endif
+
 #if UART_PRESENT(SERIAL_PORT)
   extern ring_buffer rx_buffer;
+  extern volatile uint16_t rx_overruns; // Bytes the UART lost because it wasn't read in time
+  extern volatile uint16_t rx_dropped;  // Bytes thrown away because the ring was full
+  #if TX_BUFFER_SIZE > 0
+    extern tx_ring_buffer tx_buffer;
+  #endif
 #endif
 
 class MarlinSerial { //: public Stream
@@ -93,31 +118,21 @@ class MarlinSerial { //: public Stream
     void flush(void);
 
     FORCE_INLINE int available(void) {
-      return (unsigned int)(RX_BUFFER_SIZE + rx_buffer.head - rx_buffer.tail) % RX_BUFFER_SIZE;
+      return (uint8_t)(rx_buffer.head - rx_buffer.tail) & RX_BUFFER_MASK;
     }
 
-    FORCE_INLINE void write(uint8_t c) {
-      while (!TEST(M_UCSRxA, M_UDREx))
-        ;
-
-      M_UDRx = c;
-    }
+    #if TX_BUFFER_SIZE > 0
+      void write(uint8_t c);
+      void flushTX(void);
+    #else
+      FORCE_INLINE void write(uint8_t c) {
+        while (!TEST(M_UCSRxA, M_UDREx))
+          ;
 
-    FORCE_INLINE void checkRx(void) {
-      if (TEST(M_UCSRxA, M_RXCx)) {
-        unsigned char c  =  M_UDRx;
-        int i = (unsigned int)(rx_buffer.head + 1) % RX_BUFFER_SIZE;
-
-        // if we should be storing the received character into the location
-        // just before the tail (meaning that the head would advance to the
-        // current location of the tail), we're about to overflow the buffer
-        // and so we don't write the character or advance the head.
-        if (i != rx_buffer.tail) {
-          rx_buffer.buffer[rx_buffer.head] = c;
-          rx_buffer.head = i;
-        }
+        M_UDRx = c;
       }
-    }
+      FORCE_INLINE void flushTX(void) { }
+    #endif
 
   private:
     void printNumber(unsigned long, uint8_t);
@@ -52,10 +52,22 @@
 #include "pins_arduino.h"
 #include "math.h"
 #include "buzzer.h"
+#include "gcode_parse.h"
 
 #ifdef LASER
 #include <SPI.h>
 #include "laser.h"
+#include "galvo_dac.h"
+#include "galvo_correction.h"
+#ifdef GALVO_CALIBRATION
+  #include "galvo_mesh.h"
+#endif
+#ifdef LASER_HATCH
+  #include "hatch.h"
+#endif
+#ifdef BINARY_PROTOCOL
+  #include "binary_protocol.h"
+#endif
 #else
 #include "temperature.h"
 #endif
@@ -93,6 +105,8 @@
  * G2  - CW ARC
  * G3  - CCW ARC
  * G4  - Dwell S<seconds> or P<milliseconds>
+ * G7  - Raster line X Y (start) I J (direction) P<pitch> F D<base64 pixels> (LASER_RASTER)
+ * G8  - Polyline X Y (start) F D<base64 packed deltas> (LASER_POLYLINE)
  * G10 - retract filament according to settings of M207
  * G11 - retract recover filament according to settings of M208
  * G28 - Home one or more axes
@@ -206,6 +220,8 @@
  * M665 - Set delta configurations: L<diagonal rod> R<delta radius> S<segments/s>
  * M666 - Set delta endstop adjustment
  * M605 - Set dual x-carriage movement mode: S<mode> [ X<duplication x-offset> R<duplication temp offset> ]
+ * M680 - Report bytes lost on serial receive. R to clear the counts.
+ * M691 - Windowed "ok" with the free buffer space: S<0|1>
  * M907 - Set digital trimpot motor current using axis codes.
  * M908 - Control digital trimpot directly.
  * M350 - Set microstepping mode.
@@ -248,11 +264,26 @@ bool axis_known_position[3] = { false };
 
 static long gcode_N, gcode_LastN, Stopped_gcode_LastN = 0;
 
-static char *current_command, *current_command_args;
-static int cmd_queue_index_r = 0;
-static int cmd_queue_index_w = 0;
+static char *current_command;
+
+// Commands are queued back to back in a byte ring, each as a header byte (the
+// length with the NUL, and COMMAND_FROM_SD) and then the text, so a short line
+// takes only the room it needs. A command never wraps: if the longest one
+// won't fit before the end, a 0 header is left there and the next one starts
+// at 0. Commands are run where they are.
+#ifndef CMD_QUEUE_SIZE
+  #define CMD_QUEUE_SIZE (BUFSIZE * MAX_CMD_SIZE)
+#endif
+#define COMMAND_FROM_SD 0x80
+static char command_queue[CMD_QUEUE_SIZE];
+static uint16_t cmd_queue_index_r = 0; ///< Header of the oldest command
+static uint16_t cmd_queue_index_w = 0; ///< Header of the next command to be queued
 static int commands_in_queue = 0;
-static char command_queue[BUFSIZE][MAX_CMD_SIZE];
+
+#ifdef WINDOWED_OK
+  static bool windowed_ok = false;     // M691: ok reports the free buffer space
+  static bool windowed_resend = false; // A resend is asked for and not yet answered
+#endif
 
 float homing_feedrate[] = HOMING_FEEDRATE;
 bool axis_relative_modes[] = AXIS_RELATIVE_MODES;
@@ -278,7 +309,6 @@ static bool relative_mode = false;  //Determines Absolute or Relative Coordinate
 static char serial_char;
 static int serial_count = 0;
 static boolean comment_mode = false;
-static char *seen_pointer; ///< A pointer to find chars in the command string (X, Y, Z, E, etc.)
 const char* queued_commands_P= NULL; /* pointer to the current line in the active sequence of commands, or NULL when none */
 const int sensitive_pins[] = SENSITIVE_PINS; ///< Sensitive pin list for M42
 // Inactivity shutdown
@@ -408,10 +438,6 @@ bool target_direction;
    static bool filrunoutEnqueued = false;
 #endif
 
-#ifdef SDSUPPORT
-  static bool fromsd[BUFSIZE];
-#endif
-
 #if NUM_SERVOS > 0
   Servo servo[NUM_SERVOS];
 #endif
@@ -421,11 +447,20 @@ bool target_direction;
   boolean chdkActive = false;
 #endif
 
+#ifdef BINARY_PROTOCOL
+  static bool binary_mode = false;
+  static uint8_t binary_last_sequence;
+  static bool binary_resend = false; // Dropping frames until the one asked for
+#endif
+
 //===========================================================================
 //================================ Functions ================================
 //===========================================================================
 
 void process_next_command();
+#ifdef BINARY_PROTOCOL
+  static void get_binary_frames();
+#endif
 
 bool setTargetedHotend(int code);
 
@@ -495,6 +530,69 @@ void enqueuecommands_P(const char* pgcode) {
   drain_queued_commands_P(); // first command executed asap (when possible)
 }
 
+/**
+ * Make room for the longest command at cmd_queue_index_w, going back to the
+ * start of the ring if need be. Returns false if the queue is too full.
+ * Call it before the first byte of a command goes in.
+ */
+static bool command_queue_room() {
+  const uint16_t need = MAX_CMD_SIZE + 1;
+  if (!commands_in_queue) {
+    cmd_queue_index_r = cmd_queue_index_w = 0;
+    return true;
+  }
+  uint16_t r = cmd_queue_index_r, w = cmd_queue_index_w;
+  if (w < r) return r - w >= need;
+  if (w == r) return false;
+  if (CMD_QUEUE_SIZE - w >= need) return true;
+  if (r < need) return false;
+  command_queue[w] = 0; // Go back to the start
+  cmd_queue_index_w = 0;
+  return true;
+}
+
+#if defined(ADVANCED_OK) || defined(WINDOWED_OK)
+  // How many more of the longest command would fit
+  static int command_queue_free() {
+    const uint16_t need = MAX_CMD_SIZE + 1;
+    if (!commands_in_queue) return CMD_QUEUE_SIZE / need;
+    uint16_t r = cmd_queue_index_r, w = cmd_queue_index_w;
+    if (w < r) return (r - w) / need;
+    if (w == r) return 0;
+    return (CMD_QUEUE_SIZE - w) / need + r / need;
+  }
+#endif
+
+// Where the text of the next command goes
+FORCE_INLINE char *command_queue_text() { return &command_queue[cmd_queue_index_w + 1]; }
+
+// Queue the command written at command_queue_text(). length counts the NUL.
+static void command_queue_push(uint8_t length, bool from_sd=false) {
+  command_queue[cmd_queue_index_w] = length | (from_sd ? COMMAND_FROM_SD : 0);
+  cmd_queue_index_w += length + 1;
+  if (cmd_queue_index_w >= CMD_QUEUE_SIZE) cmd_queue_index_w = 0;
+  commands_in_queue++;
+}
+
+// Header of the oldest command. Only while commands_in_queue.
+FORCE_INLINE uint8_t command_queue_header() {
+  if (!command_queue[cmd_queue_index_r]) cmd_queue_index_r = 0; // Gone back to the start
+  return command_queue[cmd_queue_index_r];
+}
+
+// Text of the oldest command. Only while commands_in_queue.
+FORCE_INLINE char *command_queue_first() {
+  command_queue_header();
+  return &command_queue[cmd_queue_index_r + 1];
+}
+
+// Drop the oldest command
+static void command_queue_pop() {
+  cmd_queue_index_r += (command_queue_header() & ~COMMAND_FROM_SD) + 1;
+  if (cmd_queue_index_r >= CMD_QUEUE_SIZE) cmd_queue_index_r = 0;
+  commands_in_queue--;
+}
+
 /**
  * Copy a command directly into the main command buffer, from RAM.
  *
@@ -503,17 +601,17 @@ void enqueuecommands_P(const char* pgcode) {
  */
 bool enqueuecommand(const char *cmd) {
 
-  if (*cmd == ';' || commands_in_queue >= BUFSIZE) return false;
+  size_t length = strlen(cmd) + 1;
+  if (*cmd == ';' || length > MAX_CMD_SIZE || !command_queue_room()) return false;
 
   // This is dangerous if a mixing of serial and this happens
-  char *command = command_queue[cmd_queue_index_w];
+  char *command = command_queue_text();
   strcpy(command, cmd);
   SERIAL_ECHO_START;
   SERIAL_ECHOPGM(MSG_Enqueueing);
   SERIAL_ECHO(command);
   SERIAL_ECHOLNPGM("\"");
-  cmd_queue_index_w = (cmd_queue_index_w + 1) % BUFSIZE;
-  commands_in_queue++;
+  command_queue_push(length);
   return true;
 }
 
@@ -599,6 +697,7 @@ void setup_galvos()
 {
 #ifdef GALVO_SS_PIN
 	pinMode(GALVO_SS_PIN, OUTPUT);
+	galvo_dac_init();
 	SPI.setClockDivider(SPI_CLOCK_DIV2);
 	SPI.begin();
 	pinMode(STEP_TRIGGER, OUTPUT);
@@ -612,6 +711,9 @@ void setup_laser()
 	SET_OUTPUT(LASER_FIRING_PIN);
 	laser_init();
 	laser_extinguish();
+	#ifdef LASER_PULSED
+	  laser_pulse_init();
+	#endif
 #endif  
 
 }
@@ -643,6 +745,12 @@ void setup() {
 #ifdef LASER
   setup_galvos();
   setup_laser();
+  #ifdef GALVO_FIELD_CORRECTION
+    galvo_correction_init(laser_res_distance);
+  #endif
+  #ifdef GALVO_KINEMATICS
+    galvo_kinematics_init(laser_res_distance);
+  #endif
 #endif
   MYSERIAL.begin(BAUDRATE);
   SERIAL_PROTOCOLLNPGM("start");
@@ -678,10 +786,6 @@ void setup() {
   SERIAL_ECHOPGM(MSG_PLANNER_BUFFER_BYTES);
   SERIAL_ECHOLN((int)sizeof(block_t)*BLOCK_BUFFER_SIZE);
 
-  #ifdef SDSUPPORT
-    for (int8_t i = 0; i < BUFSIZE; i++) fromsd[i] = false;
-  #endif
-
   // loads data from EEPROM if available else uses defaults (and resets step acceleration rate)
   Config_RetrieveSettings();
   lcd_init();
@@ -732,7 +836,7 @@ void setup() {
  *  - Call LCD update
  */
 void loop() {
-  if (commands_in_queue < BUFSIZE - 1) get_command();
+  get_command();
 
   #ifdef SDSUPPORT
     card.checkautostart(false);
@@ -743,7 +847,7 @@ void loop() {
     #ifdef SDSUPPORT
 
       if (card.saving) {
-        char *command = command_queue[cmd_queue_index_r];
+        char *command = command_queue_first();
         if (strstr_P(command, PSTR("M29"))) {
           // M29 closes the file
           card.closefile();
@@ -767,8 +871,7 @@ void loop() {
 
     #endif // SDSUPPORT
 
-    commands_in_queue--;
-    cmd_queue_index_r = (cmd_queue_index_r + 1) % BUFSIZE;
+    command_queue_pop();
   }
   checkHitEndstops();
   idle();
@@ -803,10 +906,14 @@ void get_command() {
     }
   #endif
 
+  #ifdef BINARY_PROTOCOL
+    if (binary_mode) get_binary_frames(); else
+  #endif
+
   //
   // Loop while serial characters are incoming and the queue is not full
   //
-  while (commands_in_queue < BUFSIZE && MYSERIAL.available() > 0) {
+  while (MYSERIAL.available() > 0 && (serial_count || command_queue_room())) {
 
     #ifdef NO_TIMEOUTS
       last_command_time = ms;
@@ -824,28 +931,31 @@ void get_command() {
 
       if (!serial_count) return; // empty lines just exit
 
-      char *command = command_queue[cmd_queue_index_w];
+      char *command = command_queue_text();
       command[serial_count] = 0; // terminate string
 
-      // this item in the queue is not from sd
-      #ifdef SDSUPPORT
-        fromsd[cmd_queue_index_w] = false;
-      #endif
-
-      char *npos = strchr(command, 'N');
+      // Only a first word can be the line number, as an N further on may be
+      // in G7/G8 data. M110 sets the number with an N of its own.
+      char *npos = (*command == 'N') ? command : NULL;
       char *apos = strchr(command, '*');
-      if (npos) {
-
-        boolean M110 = strstr_P(command, PSTR("M110")) != NULL;
+      boolean M110 = strstr_P(command, PSTR("M110")) != NULL;
+      if (M110) {
+        char *n2pos = strchr(command + 4, 'N');
+        if (n2pos) npos = n2pos;
+      }
 
-        if (M110) {
-          char *n2pos = strchr(command + 4, 'N');
-          if (n2pos) npos = n2pos;
-        }
+      if (npos) {
 
-        gcode_N = strtol(npos + 1, NULL, 10);
+        gcode_N = code_read_long(npos + 1);
 
         if (gcode_N != gcode_LastN + 1 && !M110) {
+          #ifdef WINDOWED_OK
+            // Lines sent after the one asked for again
+            if (windowed_ok && windowed_resend) {
+              serial_count = 0;
+              return;
+            }
+          #endif
           gcode_line_error(PSTR(MSG_ERR_LINE_NO));
           return;
         }
@@ -854,7 +964,7 @@ void get_command() {
           byte checksum = 0, count = 0;
           while (command[count] != '*') checksum ^= command[count++];
 
-          if (strtol(apos + 1, NULL, 10) != checksum) {
+          if (code_read_long(apos + 1) != checksum) {
             gcode_line_error(PSTR(MSG_ERR_CHECKSUM_MISMATCH));
             return;
           }
@@ -866,6 +976,9 @@ void get_command() {
         }
 
         gcode_LastN = gcode_N;
+        #ifdef WINDOWED_OK
+          windowed_resend = false;
+        #endif
         // if no errors, continue parsing
       }
       else if (apos) { // No '*' without 'N'
@@ -877,7 +990,7 @@ void get_command() {
       if (IsStopped()) {
         char *gpos = strchr(command, 'G');
         if (gpos) {
-          int codenum = strtol(gpos + 1, NULL, 10);
+          int codenum = code_read_long(gpos + 1);
           switch (codenum) {
             case 0:
             case 1:
@@ -893,22 +1006,21 @@ void get_command() {
       // If command was e-stop process now
       if (strcmp(command, "M112") == 0) kill(PSTR(MSG_KILLED));
 
-      cmd_queue_index_w = (cmd_queue_index_w + 1) % BUFSIZE;
-      commands_in_queue += 1;
+      command_queue_push(serial_count + 1);
 
       serial_count = 0; //clear buffer
     }
     else if (serial_char == '\\') {  // Handle escapes
-      if (MYSERIAL.available() > 0 && commands_in_queue < BUFSIZE) {
+      if (MYSERIAL.available() > 0) {
         // if we have one more character, copy it over
         serial_char = MYSERIAL.read();
-        command_queue[cmd_queue_index_w][serial_count++] = serial_char;
+        command_queue_text()[serial_count++] = serial_char;
       }
       // otherwise do nothing
     }
     else { // its not a newline, carriage return or escape char
       if (serial_char == ';') comment_mode = true;
-      if (!comment_mode) command_queue[cmd_queue_index_w][serial_count++] = serial_char;
+      if (!comment_mode) command_queue_text()[serial_count++] = serial_char;
     }
   }
 
@@ -923,7 +1035,7 @@ void get_command() {
     static bool stop_buffering = false;
     if (commands_in_queue == 0) stop_buffering = false;
 
-    while (!card.eof() && commands_in_queue < BUFSIZE && !stop_buffering) {
+    while (!card.eof() && !stop_buffering && (serial_count || command_queue_room())) {
       int16_t n = card.get();
       serial_char = (char)n;
       if (serial_char == '\n' || serial_char == '\r' ||
@@ -949,54 +1061,22 @@ void get_command() {
           comment_mode = false; //for new command
           return; //if empty line
         }
-        command_queue[cmd_queue_index_w][serial_count] = 0; //terminate string
+        command_queue_text()[serial_count] = 0; //terminate string
         // if (!comment_mode) {
-        fromsd[cmd_queue_index_w] = true;
-        commands_in_queue += 1;
-        cmd_queue_index_w = (cmd_queue_index_w + 1) % BUFSIZE;
+        command_queue_push(serial_count + 1, true);
         // }
         comment_mode = false; //for new command
         serial_count = 0; //clear buffer
       }
       else {
         if (serial_char == ';') comment_mode = true;
-        if (!comment_mode) command_queue[cmd_queue_index_w][serial_count++] = serial_char;
+        if (!comment_mode) command_queue_text()[serial_count++] = serial_char;
       }
     }
 
   #endif // SDSUPPORT
 }
 
-bool code_has_value() {
-  int i = 1;
-  char c = seen_pointer[i];
-  if (c == '-' || c == '+') c = seen_pointer[++i];
-  if (c == '.') c = seen_pointer[++i];
-  return (c >= '0' && c <= '9');
-}
-
-float code_value() {
-  float ret;
-  char *e = strchr(seen_pointer, 'E');
-  if (e) {
-    *e = 0;
-    ret = strtod(seen_pointer+1, NULL);
-    *e = 'E';
-  }
-  else
-    ret = strtod(seen_pointer+1, NULL);
-  return ret;
-}
-
-long code_value_long() { return strtol(seen_pointer + 1, NULL, 10); }
-
-int16_t code_value_short() { return (int16_t)strtol(seen_pointer + 1, NULL, 10); }
-
-bool code_seen(char code) {
-  seen_pointer = strchr(current_command_args, code); // +3 since "G0 " is the shortest prefix
-  return (seen_pointer != NULL);  //Return True if a character was found
-}
-
 #define DEFINE_PGM_READ_ANY(type, reader)       \
     static inline type pgm_read_any(const type *p)  \
     { return pgm_read_##reader##_near(p); }
@@ -1130,21 +1210,48 @@ inline void set_homing_bump_feedrate(AxisEnum axis) {
     SERIAL_ECHOLN("Warning: The Homing Bump Feedrate Divisor cannot be less than 1");
   }
 }
+/**
+ * Start a line to a cartesian position. The laser's planner works in
+ * corrected galvo space, so the position goes through calculate_galvo().
+ */
+inline void plan_cartesian_line(float x, float y, float z, float e, float mm_s) {
+  #ifdef LASER
+    float cartesian[3] = { x, y, z };
+    calculate_galvo(cartesian);
+    plan_buffer_line(galvo[X_AXIS], galvo[Y_AXIS], galvo[Z_AXIS], e, mm_s, active_extruder);
+  #else
+    plan_buffer_line(x, y, z, e, mm_s, active_extruder);
+  #endif
+}
 inline void line_to_current_position() {
-  plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], feedrate/60, active_extruder);
+  plan_cartesian_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], feedrate/60);
 }
 inline void line_to_z(float zPosition) {
-  plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], zPosition, current_position[E_AXIS], feedrate/60, active_extruder);
+  plan_cartesian_line(current_position[X_AXIS], current_position[Y_AXIS], zPosition, current_position[E_AXIS], feedrate/60);
 }
 inline void line_to_destination(float mm_m) {
-  plan_buffer_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], mm_m/60, active_extruder);
+  plan_cartesian_line(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], destination[E_AXIS], mm_m/60);
 }
 inline void line_to_destination() {
   line_to_destination(feedrate);
 }
 inline void sync_plan_position() {
-  plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS]);
+  #ifdef LASER
+    // The planner works in corrected galvo space
+    calculate_galvo(current_position);
+    plan_set_position(galvo[X_AXIS], galvo[Y_AXIS], galvo[Z_AXIS], current_position[E_AXIS]);
+  #else
+    plan_set_position(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS]);
+  #endif
 }
+#ifdef LASER_LAYER_REPLAY
+  // Keep a move from the current position for M669, before it's cut into
+  // galvo segments. Moves that change Z aren't kept.
+  inline void record_layer_move(float x, float y, float z, bool laser_on) {
+    if (layer_recording && z == current_position[Z_AXIS])
+      plan_record_move(x, y, feedrate/60, laser_on);
+  }
+#endif
 #if defined(DELTA) || defined(SCARA)
   inline void sync_plan_position_delta() {
     calculate_delta(current_position);
@@ -2046,10 +2153,16 @@ void plan_arc(
     arc_target[E_AXIS] += extruder_per_segment;
 
     clamp_to_software_endstops(arc_target);
-    plan_buffer_line(arc_target[X_AXIS], arc_target[Y_AXIS], arc_target[Z_AXIS], arc_target[E_AXIS], feed_rate, active_extruder);
+    plan_cartesian_line(arc_target[X_AXIS], arc_target[Y_AXIS], arc_target[Z_AXIS], arc_target[E_AXIS], feed_rate);
+    #ifdef LASER_LAYER_REPLAY
+      record_layer_move(arc_target[X_AXIS], arc_target[Y_AXIS], target[Z_AXIS], extruder_travel > 0);
+    #endif
   }
   // Ensure last segment arrives at target location.
-  plan_buffer_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feed_rate, active_extruder);
+  plan_cartesian_line(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], target[E_AXIS], feed_rate);
+  #ifdef LASER_LAYER_REPLAY
+    record_layer_move(target[X_AXIS], target[Y_AXIS], target[Z_AXIS], extruder_travel > 0);
+  #endif
 
   // As far as the parser is concerned, the position is now == target. In reality the
   // motion control system might still be processing the action and the real tool position
@@ -2106,6 +2219,265 @@ inline void gcode_G4() {
   while (millis() < codenum) idle();
 }
 
+#if defined(LASER_RASTER) || defined(LASER_POLYLINE)
+
+  // Decode base64 data. Returns the number of bytes, or -1 if the data is bad.
+  static int base64_decode(const char *data, uint8_t *bytes, int max_bytes) {
+    int count = 0, bits = 0;
+    unsigned long buffer = 0;
+    for (; *data && *data != ' ' && *data != '='; data++) {
+      char c = *data;
+      int value;
+      if (c >= 'A' && c <= 'Z') value = c - 'A';
+      else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+      else if (c >= '0' && c <= '9') value = c - '0' + 52;
+      else if (c == '+') value = 62;
+      else if (c == '/') value = 63;
+      else return -1;
+      buffer = (buffer << 6) | value;
+      bits += 6;
+      if (bits >= 8) {
+        bits -= 8;
+        if (count >= max_bytes) return -1;
+        bytes[count++] = buffer >> bits;
+      }
+    }
+    return count;
+  }
+
+#endif
+
+#if defined(LASER_HATCH) || defined(LASER_POLYLINE) || defined(BINARY_PROTOCOL) || defined(LASER_LAYER_REPLAY)
+
+  // Marking move to xy, in segments like prepare_move_laser(). Each segment
+  // moves E one step so LASER_EXTRUDER fires the laser along all of them.
+  static void laser_mark_to(const float xy[2]) {
+    float start[2] = { current_position[X_AXIS], current_position[Y_AXIS] },
+          dx = xy[X_AXIS] - start[X_AXIS],
+          dy = xy[Y_AXIS] - start[Y_AXIS],
+          seconds = 6000 * sqrt(dx * dx + dy * dy) / feedrate / feedrate_multiplier;
+    int segments = max(1, int(laser_segments_per_second * seconds));
+    long e_steps = lround(current_position[E_AXIS] * axis_steps_per_unit[E_AXIS]);
+    #ifdef LASER_LAYER_REPLAY
+      record_layer_move(xy[X_AXIS], xy[Y_AXIS], current_position[Z_AXIS], true);
+    #endif
+    set_destination_to_current();
+    for (int s = 1; s <= segments; s++) {
+      float fraction = float(s) / float(segments);
+      destination[X_AXIS] = start[X_AXIS] + dx * fraction;
+      destination[Y_AXIS] = start[Y_AXIS] + dy * fraction;
+      destination[E_AXIS] = (e_steps + s) / axis_steps_per_unit[E_AXIS];
+      calculate_galvo(destination);
+      plan_buffer_line(galvo[X_AXIS], galvo[Y_AXIS], galvo[Z_AXIS], destination[E_AXIS], feedrate/60*feedrate_multiplier/100.0, active_extruder);
+    }
+    set_current_to_destination();
+  }
+
+#endif
+
+#ifdef LASER_RASTER
+
+  static float raster_direction[2] = { 1, 0 };
+  static float raster_pitch = LASER_RASTER_PITCH;
+  static float raster_next[2];      // Where the last line's pixels ended
+
+  // What the last raster line left behind
+  #define RASTER_NONE 0             // No line yet
+  #define RASTER_ENDED 1            // A lead-out past raster_next
+  #define RASTER_JOINED 2           // The head at raster_next, at scan speed (C)
+  static uint8_t raster_state = RASTER_NONE;
+
+  /**
+   * G7: Raster line
+   *
+   *  X<pos> Y<pos>  Start of the line. Without them the line carries on
+   *                 from where the last line's pixels ended.
+   *  I<dx> J<dy>    Scan direction (default: as before, +X to start with)
+   *  P<mm>          Pixel pitch (default: as before)
+   *  F<feedrate>    Scan speed
+   *  C              More of the line follows in the next G7: no lead-out
+   *  D<base64>      Pixel intensities, one byte (0-255) each. Must come last.
+   *
+   * The line is cut into segments on pixel boundaries like any other laser
+   * move, and the stepper interrupt sets the laser pixel by pixel.
+   *
+   * Laser-off lead-in and lead-out moves of v^2/2a overscan the line, so the
+   * head is at the scan speed over every pixel. A line that carries on from
+   * one sent with C, in the same direction, needs no lead-in.
+   */
+  inline void gcode_G7() {
+    char *data = strchr(current_command_args, 'D');
+    if (!data) {
+      SERIAL_ERROR_START;
+      SERIAL_ERRORLNPGM("No raster data.");
+      return;
+    }
+    code_args_end(data++); // Keep the data out of the parameter search
+
+    uint8_t pixels[MAX_CMD_SIZE * 3 / 4];
+    int count = base64_decode(data, pixels, sizeof(pixels));
+    if (count <= 0) {
+      SERIAL_ERROR_START;
+      SERIAL_ERRORLNPGM("Bad raster data.");
+      return;
+    }
+
+    bool turned = code_seen('I') || code_seen('J');
+    if (turned) {
+      float dx = code_seen('I') ? code_value() : 0,
+            dy = code_seen('J') ? code_value() : 0,
+            length = sqrt(dx * dx + dy * dy);
+      if (length < 0.000001) {
+        SERIAL_ERROR_START;
+        SERIAL_ERRORLNPGM("Bad raster direction.");
+        return;
+      }
+      raster_direction[X_AXIS] = dx / length;
+      raster_direction[Y_AXIS] = dy / length;
+    }
+    if (code_seen('P') && code_value() > 0) raster_pitch = code_value();
+    if (code_seen('F') && code_value() > 0) feedrate = code_value();
+
+    float start[2] = { current_position[X_AXIS], current_position[Y_AXIS] };
+    if (code_seen('X') || code_seen('Y')) {
+      for (int i = X_AXIS; i <= Y_AXIS; i++)
+        if (code_seen(axis_codes[i]))
+          start[i] = code_value() + (axis_relative_modes[i] || relative_mode ? current_position[i] : 0);
+    }
+    else if (raster_state != RASTER_NONE) {
+      start[X_AXIS] = raster_next[X_AXIS];
+      start[Y_AXIS] = raster_next[Y_AXIS];
+    }
+    bool joined = code_seen('C');
+
+    // Distance to reach the scan speed from a stop
+    float speed = feedrate / 60 * feedrate_multiplier / 100.0,
+          overscan = speed * speed / (2 * plan_raster_acceleration(raster_direction));
+    if (raster_state != RASTER_JOINED || turned
+        || start[X_AXIS] != current_position[X_AXIS] || start[Y_AXIS] != current_position[Y_AXIS]) {
+      // Laser-off moves to the start of the lead-in, and along it
+      set_destination_to_current();
+      for (int i = X_AXIS; i <= Y_AXIS; i++) destination[i] = start[i] - raster_direction[i] * overscan;
+      prepare_move();
+      for (int i = X_AXIS; i <= Y_AXIS; i++) destination[i] = start[i];
+      prepare_move();
+    }
+
+    // Segments on pixel boundaries, at the usual segment rate, and two or
+    // more galvo steps long so none rounds to nothing in the planner
+    float seconds = 6000 * raster_pitch * count / feedrate / feedrate_multiplier,
+          steps = raster_pitch * count * max(fabs(raster_direction[X_AXIS]) * axis_steps_per_unit[X_AXIS],
+                                             fabs(raster_direction[Y_AXIS]) * axis_steps_per_unit[Y_AXIS]);
+    int segments = constrain(int(laser_segments_per_second * seconds), 1, count);
+    NOMORE(segments, max(1, int(steps / 2)));
+    set_destination_to_current();
+    for (int s = 1, done = 0; s <= segments; s++) {
+      int end = (long)count * s / segments;
+      for (int i = X_AXIS; i <= Y_AXIS; i++)
+        destination[i] = start[i] + raster_direction[i] * raster_pitch * end;
+      calculate_galvo(destination);
+      plan_raster_pixels(pixels + done, end - done);
+      plan_buffer_line(galvo[X_AXIS], galvo[Y_AXIS], galvo[Z_AXIS], destination[E_AXIS], feedrate/60*feedrate_multiplier/100.0, active_extruder);
+      done = end;
+    }
+    set_current_to_destination();
+    raster_next[X_AXIS] = current_position[X_AXIS];
+    raster_next[Y_AXIS] = current_position[Y_AXIS];
+
+    if (joined)
+      raster_state = RASTER_JOINED;
+    else {
+      // Laser-off lead-out, slowing down past the last pixel
+      for (int i = X_AXIS; i <= Y_AXIS; i++) destination[i] = raster_next[i] + raster_direction[i] * overscan;
+      prepare_move();
+      raster_state = RASTER_ENDED;
+    }
+  }
+
+#endif // LASER_RASTER
+
+#ifdef LASER_POLYLINE
+
+  // Next packed delta: zigzag coded (0, -1, 1, -2, ... as 0, 1, 2, 3, ...),
+  // 7 bits a byte, low bits first, top bit set on all but the last byte.
+  static bool polyline_delta(const uint8_t *&p, const uint8_t *end, long &delta) {
+    unsigned long value = 0;
+    for (uint8_t shift = 0; shift < 28; shift += 7) {
+      if (p >= end) return false;
+      uint8_t b = *p++;
+      value |= (unsigned long)(b & 0x7F) << shift;
+      if (!(b & 0x80)) {
+        delta = (value & 1) ? -(long)(value >> 1) - 1 : (long)(value >> 1);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * G8: Polyline
+   *
+   *  X<pos> Y<pos>  Start of the polyline, reached with the laser off.
+   *                 Without them the polyline carries on from here.
+   *  F<feedrate>    Marking speed
+   *  D<base64>      Packed X/Y deltas to each vertex in turn, in X and Y
+   *                 steps (the galvo grid). Must come last.
+   *
+   * Each vertex is marked straight into the planner, so a contour costs a
+   * few bytes per vertex instead of a G1 line.
+   */
+  inline void gcode_G8() {
+    char *data = strchr(current_command_args, 'D');
+    if (!data) {
+      SERIAL_ERROR_START;
+      SERIAL_ERRORLNPGM("No polyline data.");
+      return;
+    }
+    code_args_end(data++); // Keep the data out of the parameter search
+
+    uint8_t packed[MAX_CMD_SIZE * 3 / 4];
+    int count = base64_decode(data, packed, sizeof(packed));
+    if (count <= 0) {
+      SERIAL_ERROR_START;
+      SERIAL_ERRORLNPGM("Bad polyline data.");
+      return;
+    }
+
+    if (code_seen('F') && code_value() > 0) feedrate = code_value();
+
+    if (code_seen('X') || code_seen('Y')) {
+      // Laser-off move to the start of the polyline
+      set_destination_to_current();
+      for (int i = X_AXIS; i <= Y_AXIS; i++)
+        if (code_seen(axis_codes[i]))
+          destination[i] = code_value() + (axis_relative_modes[i] || relative_mode ? current_position[i] : 0);
+      prepare_move();
+    }
+
+    // Add up the deltas in steps so the vertices don't drift
+    long grid[2] = {
+      lround(current_position[X_AXIS] * axis_steps_per_unit[X_AXIS]),
+      lround(current_position[Y_AXIS] * axis_steps_per_unit[Y_AXIS])
+    };
+    const uint8_t *p = packed, *end = packed + count;
+    while (p < end) {
+      long delta[2];
+      if (!polyline_delta(p, end, delta[X_AXIS]) || !polyline_delta(p, end, delta[Y_AXIS])) {
+        SERIAL_ERROR_START;
+        SERIAL_ERRORLNPGM("Bad polyline data.");
+        return;
+      }
+      float xy[2];
+      for (int i = X_AXIS; i <= Y_AXIS; i++) {
+        grid[i] += delta[i];
+        xy[i] = grid[i] / axis_steps_per_unit[i];
+      }
+      laser_mark_to(xy);
+    }
+  }
+
+#endif // LASER_POLYLINE
+
 #ifdef FWRETRACT
 
   /**
@@ -2488,7 +2860,7 @@ inline void gcode_G28() {
           if (iy & 1) ix = (MESH_NUM_X_POINTS - 1) - ix; // zig-zag
           mbl.set_z(ix, iy, current_position[Z_AXIS]);
           current_position[Z_AXIS] = MESH_HOME_SEARCH_Z;
-          plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], homing_feedrate[X_AXIS]/60, active_extruder);
+          plan_cartesian_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], homing_feedrate[X_AXIS]/60);
           st_synchronize();
         }
         // Is there another point to sample? Move there.
@@ -2498,7 +2870,7 @@ inline void gcode_G28() {
           if (iy & 1) ix = (MESH_NUM_X_POINTS - 1) - ix; // zig-zag
           current_position[X_AXIS] = mbl.get_x(ix);
           current_position[Y_AXIS] = mbl.get_y(iy);
-          plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], homing_feedrate[X_AXIS]/60, active_extruder);
+          plan_cartesian_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], homing_feedrate[X_AXIS]/60);
           st_synchronize();
           probe_point++;
         }
@@ -2927,129 +3299,148 @@ inline void gcode_G28() {
   #endif //!Z_PROBE_SLED
 
 #endif //ENABLE_AUTO_BED_LEVELING
-	/*
-#ifdef LASER 
-	enum GalvoCalState { GalvoReport, GalvoStart, GalvoNext, GalvoSet };
-
-	inline void gcode_G29() {
-		static int probe_point = -1;
-		GalvoCalState state = code_seen('S') || code_seen('s') ? (GalvoCalState)code_value_short() : GalvoReport;
-		if (state < 0 || state > 3) {
-			SERIAL_PROTOCOLLNPGM("S out of range (0-3).");
-			return;
-		}
-		switch (state) {
-		case GalvoReport:
-			if (mbl.active) {
-				SERIAL_PROTOCOLPGM("Num X,Y: ");
-				SERIAL_PROTOCOL(MESH_NUM_X_POINTS);
-				SERIAL_PROTOCOLCHAR(',');
-				SERIAL_PROTOCOL(MESH_NUM_Y_POINTS);
-				SERIAL_PROTOCOLPGM("\nZ search height: ");
-				SERIAL_PROTOCOL(MESH_HOME_SEARCH_Z);
-				SERIAL_PROTOCOLLNPGM("\nMeasured points:");
-				for (int y = 0; y < MESH_NUM_Y_POINTS; y++) {
-					for (int x = 0; x < MESH_NUM_X_POINTS; x++) {
-						SERIAL_PROTOCOLPGM("  ");
-						SERIAL_PROTOCOL_F(mbl.z_values[y][x], 5);
-					}
-					SERIAL_EOL;
-				}
-			}
-			else
-				SERIAL_PROTOCOLLNPGM("Mesh bed leveling not active.");
-			break;
+#ifdef GALVO_CALIBRATION
+
+  enum GalvoCalState { GalvoReport, GalvoStart, GalvoNext, GalvoSet };
+
+  // Send the galvos to a calibration point, without the mesh
+  static void galvo_to_mesh_point(int probe_point) {
+    int ix = probe_point % MESH_NUM_X_POINTS,
+        iy = probe_point / MESH_NUM_X_POINTS;
+    if (iy & 1) ix = (MESH_NUM_X_POINTS - 1) - ix; // zig-zag
+    destination[X_AXIS] = gmesh.get_x(ix);
+    destination[Y_AXIS] = gmesh.get_y(iy);
+    destination[Z_AXIS] = current_position[Z_AXIS];
+    destination[E_AXIS] = current_position[E_AXIS];
+    feedrate = homing_feedrate[X_AXIS];
+    prepare_move();
+    st_synchronize();
+    SERIAL_PROTOCOLPGM("Point ");
+    SERIAL_PROTOCOL(ix + 1);
+    SERIAL_PROTOCOLCHAR(',');
+    SERIAL_PROTOCOL(iy + 1);
+    SERIAL_PROTOCOLPGM(" at X: ");
+    SERIAL_PROTOCOL(destination[X_AXIS]);
+    SERIAL_PROTOCOLPGM(" Y: ");
+    SERIAL_PROTOCOL(destination[Y_AXIS]);
+    SERIAL_EOL;
+  }
 
-		case GalvoStart:
-			mbl.reset();
-			probe_point = 0;
-			enqueuecommands_P(PSTR("G28\nG29 S2"));
-			break;
+  /**
+   * G29: Galvo field calibration. Captures the X/Y offsets that
+   *      put the spot where it's sent across the galvo field.
+   *
+   *  S0              Report the offsets
+   *  S1              Disable and clear the mesh and go to the first point
+   *  S2 Xn.nn Yn.nn  Record where the spot landed for the current point
+   *                  and go to the next one. The mesh is enabled after
+   *                  the last point.
+   *  S3 In Jn Xn.nn Yn.nn  Manually set the offsets of a single point
+   */
+  inline void gcode_G29() {
 
-		case GalvoNext:
-			if (probe_point < 0) {
-				SERIAL_PROTOCOLLNPGM("Start mesh probing with \"G29 S1\" first.");
-				return;
-			}
-			if (probe_point == 0) {
-				// Set Z to a positive value before recording the first Z.
-				current_position[Z_AXIS] = MESH_HOME_SEARCH_Z;
-				sync_plan_position();
-			}
-			else {
-				// For others, save the Z of the previous point, then raise Z again.
-				ix = (probe_point - 1) % MESH_NUM_X_POINTS;
-				iy = (probe_point - 1) / MESH_NUM_X_POINTS;
-				if (iy & 1) ix = (MESH_NUM_X_POINTS - 1) - ix; // zig-zag
-				mbl.set_z(ix, iy, current_position[Z_AXIS]);
-				current_position[Z_AXIS] = MESH_HOME_SEARCH_Z;
-				plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], homing_feedrate[X_AXIS] / 60, active_extruder);
-				st_synchronize();
-			}
-			// Is there another point to sample? Move there.
-			if (probe_point < MESH_NUM_X_POINTS * MESH_NUM_Y_POINTS) {
-				ix = probe_point % MESH_NUM_X_POINTS;
-				iy = probe_point / MESH_NUM_X_POINTS;
-				if (iy & 1) ix = (MESH_NUM_X_POINTS - 1) - ix; // zig-zag
-				current_position[X_AXIS] = mbl.get_x(ix);
-				current_position[Y_AXIS] = mbl.get_y(iy);
-				plan_buffer_line(current_position[X_AXIS], current_position[Y_AXIS], current_position[Z_AXIS], current_position[E_AXIS], homing_feedrate[X_AXIS] / 60, active_extruder);
-				st_synchronize();
-				probe_point++;
-			}
-			else {
-				// After recording the last point, activate the mbl and home
-				SERIAL_PROTOCOLLNPGM("Mesh probing done.");
-				probe_point = -1;
-				mbl.active = 1;
-				enqueuecommands_P(PSTR("G28"));
-			}
-			break;
+    static int probe_point = -1;
+    GalvoCalState state = code_seen('S') || code_seen('s') ? (GalvoCalState)code_value_short() : GalvoReport;
+    if (state < 0 || state > 3) {
+      SERIAL_PROTOCOLLNPGM("S out of range (0-3).");
+      return;
+    }
 
-		case GalvoSet:
-			if (code_seen('X') || code_seen('x')) {
-				ix = code_value_long() - 1;
-				if (ix < 0 || ix >= MESH_NUM_X_POINTS) {
-					SERIAL_PROTOCOLPGM("X out of range (1-" STRINGIFY(MESH_NUM_X_POINTS) ").\n");
-					return;
-				}
-			}
-			else {
-				SERIAL_PROTOCOLPGM("X not entered.\n");
-				return;
-			}
-			if (code_seen('Y') || code_seen('y')) {
-				iy = code_value_long() - 1;
-				if (iy < 0 || iy >= MESH_NUM_Y_POINTS) {
-					SERIAL_PROTOCOLPGM("Y out of range (1-" STRINGIFY(MESH_NUM_Y_POINTS) ").\n");
-					return;
-				}
-			}
-			else {
-				SERIAL_PROTOCOLPGM("Y not entered.\n");
-				return;
-			}
-			if (code_seen('Z') || code_seen('z')) {
-				z = code_value();
-			}
-			else {
-				SERIAL_PROTOCOLPGM("Z not entered.\n");
-				return;
-			}
-			mbl.z_values[iy][ix] = z;
-
-		} // switch(state)
-		SERIAL_PROTOCOLLNPGM("Laser Galvo Calibration");
-		SERIAL_PROTOCOLLNPGM("Homing Z axis");
-		HOMEAXIS(Z);
-		SERIAL_PROTOCOLLNPGM("Raising to max height");
-		destination[Z_AXIS] = max_length(Z_AXIS);
-		feedrate = homing_feedrate[Z_AXIS];
-		line_to_destination();
-		st_synchronize();
-	}
-#endif
-	*/
+    int ix, iy;
+    float dx, dy;
+
+    switch(state) {
+      case GalvoReport:
+        SERIAL_PROTOCOLPGM("Galvo calibration ");
+        if (gmesh.active) SERIAL_PROTOCOLLNPGM("active."); else SERIAL_PROTOCOLLNPGM("not active.");
+        SERIAL_PROTOCOLPGM("Num X,Y: ");
+        SERIAL_PROTOCOL(MESH_NUM_X_POINTS);
+        SERIAL_PROTOCOLCHAR(',');
+        SERIAL_PROTOCOL(MESH_NUM_Y_POINTS);
+        SERIAL_PROTOCOLLNPGM("\nMeasured offsets (X,Y):");
+        for (int y = 0; y < MESH_NUM_Y_POINTS; y++) {
+          for (int x = 0; x < MESH_NUM_X_POINTS; x++) {
+            SERIAL_PROTOCOLPGM("  ");
+            SERIAL_PROTOCOL_F(gmesh.x_offsets[y][x], 3);
+            SERIAL_PROTOCOLCHAR(',');
+            SERIAL_PROTOCOL_F(gmesh.y_offsets[y][x], 3);
+          }
+          SERIAL_EOL;
+        }
+        break;
+
+      case GalvoStart:
+        gmesh.reset();
+        probe_point = 0;
+        galvo_to_mesh_point(probe_point);
+        break;
+
+      case GalvoNext:
+        if (probe_point < 0) {
+          SERIAL_PROTOCOLLNPGM("Start galvo calibration with \"G29 S1\" first.");
+          return;
+        }
+        if (!code_seen('X')) {
+          SERIAL_PROTOCOLPGM("X not entered.\n");
+          return;
+        }
+        dx = code_value();
+        if (!code_seen('Y')) {
+          SERIAL_PROTOCOLPGM("Y not entered.\n");
+          return;
+        }
+        dy = code_value();
+        // Offset the point by the error seen at it
+        ix = probe_point % MESH_NUM_X_POINTS;
+        iy = probe_point / MESH_NUM_X_POINTS;
+        if (iy & 1) ix = (MESH_NUM_X_POINTS - 1) - ix; // zig-zag
+        gmesh.set_offset(ix, iy, gmesh.get_x(ix) - dx, gmesh.get_y(iy) - dy);
+        if (++probe_point < MESH_NUM_X_POINTS * MESH_NUM_Y_POINTS) {
+          galvo_to_mesh_point(probe_point);
+        }
+        else {
+          SERIAL_PROTOCOLLNPGM("Galvo calibration done.");
+          probe_point = -1;
+          gmesh.active = 1;
+        }
+        break;
+
+      case GalvoSet:
+        if (code_seen('I')) {
+          ix = code_value_long() - 1;
+          if (ix < 0 || ix >= MESH_NUM_X_POINTS) {
+            SERIAL_PROTOCOLPGM("I out of range (1-" STRINGIFY(MESH_NUM_X_POINTS) ").\n");
+            return;
+          }
+        }
+        else {
+          SERIAL_PROTOCOLPGM("I not entered.\n");
+          return;
+        }
+        if (code_seen('J')) {
+          iy = code_value_long() - 1;
+          if (iy < 0 || iy >= MESH_NUM_Y_POINTS) {
+            SERIAL_PROTOCOLPGM("J out of range (1-" STRINGIFY(MESH_NUM_Y_POINTS) ").\n");
+            return;
+          }
+        }
+        else {
+          SERIAL_PROTOCOLPGM("J not entered.\n");
+          return;
+        }
+        dx = code_seen('X') ? code_value() : gmesh.x_offsets[iy][ix];
+        dy = code_seen('Y') ? code_value() : gmesh.y_offsets[iy][ix];
+        gmesh.set_offset(ix, iy, dx, dy);
+
+    } // switch(state)
+  }
+
+  /**
+   * M420: Enable/Disable Galvo Calibration
+   */
+  inline void gcode_M420() { if (code_seen('S') && code_has_value()) gmesh.active = !!code_value_short(); }
+
+#endif // GALVO_CALIBRATION
 /**
  * G92: Set current position to given X Y Z E
  */
@@ -5286,10 +5677,484 @@ inline void gcode_M503() {
   /* Modifies default laser parameters */
   inline void gcode_M655() {
 	  if (code_seen('H')) {
-		  /* Code here to adjust height */
+		  laser_res_distance = code_value();
+		  #ifdef GALVO_FIELD_CORRECTION
+		    st_synchronize();
+		    galvo_correction_init(laser_res_distance);
+		    sync_plan_position();
+		  #endif
+		  #ifdef GALVO_KINEMATICS
+		    galvo_kinematics_init(laser_res_distance);
+		  #endif
+	  }
+	#ifdef LASER_PULSED
+	  // P<ppm> pulses per mm, D<us> pulse duration
+	  if (code_seen('P') || code_seen('D')) {
+		  if (code_seen('P') && code_value() > 0) laser.ppm = code_value();
+		  if (code_seen('D')) laser.duration = constrain(code_value_long(), 1, 30000);
+		  CRITICAL_SECTION_START;
+		  laser_pulse_init();
+		  CRITICAL_SECTION_END;
+	  }
+	#endif
+  }
+#endif
+
+#ifdef MUVE_Z_PEEL
+  /**
+   * M652: Z peel
+   *
+   *  L<mm>  Layer height. Come back down this much higher than before.
+   *
+   * Queues the lift, the pause and the return and carries on with the next
+   * commands while they run. Only a command that waits for the moves to end
+   * (G4, M400, M663) holds up reading the next layer.
+   */
+  inline void gcode_M652() {
+	  float z = current_position[Z_AXIS] + (code_seen('L') ? code_value() : 0),
+	        saved_feedrate = feedrate;
+	  set_destination_to_current();
+	  destination[Z_AXIS] += laser.peel_distance;
+	  feedrate = laser.peel_speed * 60;
+	  prepare_move();
+	  plan_buffer_dwell(laser.peel_pause * 1000);
+	  destination[Z_AXIS] = z;
+	  prepare_move();
+	  feedrate = saved_feedrate;
+  }
+
+  /**
+   * M653: Z peel settings
+   *
+   *  D<mm>    Peel distance
+   *  F<mm/s>  Peel speed
+   *  P<s>     Pause at the top
+   *
+   * Reports the settings when given no parameters.
+   */
+  inline void gcode_M653() {
+	  bool report = true;
+	  if (code_seen('D')) { laser.peel_distance = max(code_value(), 0); report = false; }
+	  if (code_seen('F') && code_value() > 0) { laser.peel_speed = code_value(); report = false; }
+	  if (code_seen('P')) { laser.peel_pause = max(code_value(), 0); report = false; }
+	  if (report) {
+		  SERIAL_ECHO_START;
+		  SERIAL_ECHOPAIR("Z peel D", laser.peel_distance);
+		  SERIAL_ECHOPAIR(" F", laser.peel_speed);
+		  SERIAL_ECHOPAIR(" P", laser.peel_pause);
+		  SERIAL_EOL;
+	  }
+  }
+#endif
+
+#ifdef GALVO_JUMP_MODE
+  /**
+   * M656: Galvo jump mode
+   *
+   *  S<0|1>          Disable/enable jumps for laser-off moves
+   *  P<n> L<mm> D<us>  Set point n of the jump settle table
+   *
+   * Reports the table when given no parameters.
+   */
+  inline void gcode_M656() {
+	  bool report = true;
+	  if (code_seen('S')) {
+		  galvo_jump_enabled = code_value_short() != 0;
+		  report = false;
+	  }
+	  if (code_seen('P')) {
+		  int p = code_value_short();
+		  if (p < 0 || p >= GALVO_JUMP_DELAY_POINTS) {
+			  SERIAL_ERROR_START;
+			  SERIAL_ERRORLNPGM("P out of range.");
+			  return;
+		  }
+		  if (code_seen('L')) galvo_jump_length[p] = max(code_value(), 0);
+		  if (code_seen('D')) galvo_jump_delay[p] = constrain(code_value(), 0, GALVO_JUMP_MAX_DELAY);
+		  report = false;
+	  }
+	  if (report) {
+		  SERIAL_ECHO_START;
+		  SERIAL_ECHOPAIR("Galvo jumps S", (unsigned long)galvo_jump_enabled);
+		  SERIAL_EOL;
+		  for (int p = 0; p < GALVO_JUMP_DELAY_POINTS; p++) {
+			  SERIAL_ECHO_START;
+			  SERIAL_ECHOPAIR("  P", (unsigned long)p);
+			  SERIAL_ECHOPAIR(" L", galvo_jump_length[p]);
+			  SERIAL_ECHOPAIR(" D", galvo_jump_delay[p]);
+			  SERIAL_EOL;
+		  }
+	  }
+  }
+#endif
+
+#ifdef LASER_DELAYS
+  /**
+   * M657: Laser delays, in microseconds
+   *
+   *  O<us>  Laser on delay, from the start of a mark
+   *  F<us>  Laser off delay, after the end of a mark
+   *  P<us>  Polygon delay, at sharp marking corners
+   *
+   * Reports the delays when given no parameters.
+   */
+  inline void gcode_M657() {
+	  bool report = true;
+	  if (code_seen('O')) { laser_on_delay = constrain(code_value_short(), 0, LASER_MAX_DELAY); report = false; }
+	  if (code_seen('F')) { laser_off_delay = constrain(code_value_short(), 0, LASER_MAX_DELAY); report = false; }
+	  if (code_seen('P')) { laser_polygon_delay = constrain(code_value_short(), 0, LASER_MAX_DELAY); report = false; }
+	  if (report) {
+		  SERIAL_ECHO_START;
+		  SERIAL_ECHOPAIR("Laser delays O", (unsigned long)laser_on_delay);
+		  SERIAL_ECHOPAIR(" F", (unsigned long)laser_off_delay);
+		  SERIAL_ECHOPAIR(" P", (unsigned long)laser_polygon_delay);
+		  SERIAL_EOL;
+	  }
+  }
+#endif
+
+#ifdef LASER_VELOCITY_POWER
+  /**
+   * M659: Velocity-proportional laser power
+   *
+   *  S<0|1>      Scale power with speed for moves planned from now on
+   *  P<percent>  Laser intensity, the power at full speed
+   *
+   * Reports the settings when given no parameters.
+   */
+  inline void gcode_M659() {
+	  bool report = true;
+	  if (code_seen('S')) { laser_velocity_power = code_value_short() != 0; report = false; }
+	  if (code_seen('P')) { laser.intensity = constrain(code_value(), 0, 100); report = false; }
+	  if (report) {
+		  SERIAL_ECHO_START;
+		  SERIAL_ECHOPAIR("Velocity power S", (unsigned long)laser_velocity_power);
+		  SERIAL_ECHOPAIR(" P", laser.intensity);
+		  SERIAL_EOL;
+	  }
+  }
+#endif
+
+#ifdef LASER_LAYER_STATS
+  static int marked_layer_number = 0; // Number of the last layer marked
+
+  /**
+   * M663: Layer marker
+   *
+   *  L<n>  Number of the layer starting here (default: one more)
+   *
+   * Queued with the moves: when the stepper reaches the first move after it,
+   * the counts of the layer before are kept for M664 and the next layer is
+   * counted from zero. Returns at once.
+   */
+  inline void gcode_M663() {
+	  marked_layer_number = code_seen('L') ? code_value_short() : marked_layer_number + 1;
+	  layer_stats_marker(marked_layer_number);
+  }
+
+  /**
+   * M664: Layer report
+   *
+   *  C  The layer in progress, instead of the last one finished
+   *
+   * Reports "L<layer> T<laser on us> M<marked mm> J<jump mm> S<starved us> B<blocks>"
+   */
+  inline void gcode_M664() {
+	  layer_stats_t stats;
+	  int layer;
+	  if (code_seen('C'))
+		  layer_stats_get(stats, layer);
+	  else
+		  layer_stats_last(stats, layer);
+	  SERIAL_PROTOCOLPGM("L"); SERIAL_PROTOCOL(layer);
+	  SERIAL_PROTOCOLPGM(" T"); SERIAL_PROTOCOL(stats.laser_on_ticks / (F_CPU / 8000000));
+	  SERIAL_PROTOCOLPGM(" M"); SERIAL_PROTOCOL(stats.marked_mm);
+	  SERIAL_PROTOCOLPGM(" J"); SERIAL_PROTOCOL(stats.jump_mm);
+	  SERIAL_PROTOCOLPGM(" S"); SERIAL_PROTOCOL(stats.starved_ticks / (F_CPU / 8000000));
+	  SERIAL_PROTOCOLPGM(" B"); SERIAL_PROTOCOL(stats.blocks);
+	  SERIAL_EOL;
+  }
+#endif
+
+#ifdef LASER_HATCH
+  /**
+   * M660: Clear the hatch polygon
+   */
+  inline void gcode_M660() {
+	  hatch.clear();
+	  #ifdef LASER_LAYER_REPLAY
+		  plan_record_hatch_changed();
+	  #endif
+  }
+
+  /**
+   * M661: Add a hatch polygon vertex
+   *
+   *  X<pos> Y<pos>  The vertex
+   *  C              Start a new contour with it
+   *
+   * Contours close back to their first vertex by themselves. All the contours
+   * together can have up to HATCH_MAX_VERTICES vertices, kept to 0.01mm
+   * within +/-327mm.
+   */
+  inline void gcode_M661() {
+	  float xy[2];
+	  for (int i = X_AXIS; i <= Y_AXIS; i++) {
+		  if (!code_seen(axis_codes[i])) {
+			  SERIAL_ERROR_START;
+			  SERIAL_ERRORLNPGM("Hatch vertex needs X and Y.");
+			  return;
+		  }
+		  xy[i] = code_value();
+	  }
+	  if (!hatch.add_vertex(xy[X_AXIS], xy[Y_AXIS], code_seen('C'))) {
+		  SERIAL_ERROR_START;
+		  if (hatch.vertices >= HATCH_MAX_VERTICES) {
+			  SERIAL_ERRORPGM("Hatch polygon full, HATCH_MAX_VERTICES: ");
+			  SERIAL_ERRORLN(HATCH_MAX_VERTICES);
+		  }
+		  else
+			  SERIAL_ERRORLNPGM("Hatch vertex out of range.");
+		  return;
+	  }
+	  #ifdef LASER_LAYER_REPLAY
+		  plan_record_hatch_changed();
+	  #endif
+  }
+
+  /**
+   * Hatch fill the polygon at the current feedrate. M662 and M669.
+   */
+  void hatch_fill(float spacing, float angle) {
+	  #ifdef LASER_LAYER_REPLAY
+		  // A recorded layer keeps the fill, not the spans it makes
+		  bool recording = layer_recording;
+		  if (recording) plan_record_hatch(spacing, angle, feedrate/60);
+		  layer_recording = false;
+	  #endif
+	  hatch.set_angle(angle);
+
+	  uint8_t edges[HATCH_MAX_VERTICES];
+	  float xy[2];
+	  bool reverse = false;
+	  for (long line = 0; ; line++) {
+		  float v = hatch.v_min + spacing * (line + 0.5);
+		  if (v >= hatch.v_max) break;
+		  uint8_t count = hatch.crossings(v, edges) & ~1;
+		  for (uint8_t n = 0; n < count; n += 2) {
+			  uint8_t a = reverse ? count - 1 - n : n,
+			          b = reverse ? a - 1 : a + 1;
+			  float ua = hatch.crossing_u(edges[a], v), ub = hatch.crossing_u(edges[b], v);
+			  if (ua == ub) continue;
+			  hatch.get_xy(ua, v, xy);
+			  set_destination_to_current();
+			  destination[X_AXIS] = xy[X_AXIS];
+			  destination[Y_AXIS] = xy[Y_AXIS];
+			  prepare_move();
+			  hatch.get_xy(ub, v, xy);
+			  laser_mark_to(xy);
+		  }
+		  if (count) reverse = !reverse;
+	  }
+	  #ifdef LASER_LAYER_REPLAY
+		  layer_recording = recording;
+	  #endif
+  }
+
+  /**
+   * M662: Hatch fill the polygon
+   *
+   *  S<mm>        Hatch spacing
+   *  A<degrees>   Hatch angle from the X axis (default 0)
+   *  F<feedrate>  Marking speed
+   *
+   * Each hatch line is cut where it crosses the contours and the spans inside
+   * are marked, every other line backwards so the jumps between them stay
+   * short. Moves between spans are laser-off moves.
+   */
+  inline void gcode_M662() {
+	  float spacing = code_seen('S') ? code_value() : 0;
+	  if (spacing <= 0) {
+		  SERIAL_ERROR_START;
+		  SERIAL_ERRORLNPGM("Bad hatch spacing.");
+		  return;
+	  }
+	  if (hatch.vertices < 3) {
+		  SERIAL_ERROR_START;
+		  SERIAL_ERRORLNPGM("No hatch polygon.");
+		  return;
+	  }
+	  float angle = code_seen('A') ? code_value() : 0;
+	  if (code_seen('F') && code_value() > 0) feedrate = code_value();
+	  hatch_fill(spacing, angle);
+	  refresh_cmd_timeout();
+  }
+#endif
+
+#ifdef LASER_LAYER_REPLAY
+  /**
+   * M667: Start recording a layer
+   *
+   * The moves from here to M668 are kept for M669, in place of any layer
+   * recorded before. They're kept as asked for, before they're cut into
+   * galvo segments: a G0/G1, a polyline line or an arc segment is one
+   * record, a feedrate change another, and an M662 hatch fill three, however
+   * many lines it makes. Z moves aren't recorded.
+   */
+  inline void gcode_M667() { plan_record_start(current_position[X_AXIS], current_position[Y_AXIS]); }
+
+  /**
+   * M668: Stop recording a layer
+   *
+   * Reports the number of records kept. A layer that needs more than
+   * LAYER_REPLAY_MOVES records, has raster lines or fills a hatch polygon
+   * that's changed since isn't kept, and the error says which.
+   */
+  inline void gcode_M668() {
+	  switch (plan_record_end()) {
+		  case LAYER_RECORD_OK:
+			  SERIAL_ECHO_START;
+			  SERIAL_ECHOPAIR("Layer recorded, records: ", (unsigned long)layer_record_count);
+			  SERIAL_EOL;
+			  break;
+		  case LAYER_RECORD_FULL:
+			  SERIAL_ERROR_START;
+			  SERIAL_ERRORPGM("Layer not recorded, records: ");
+			  SERIAL_ERROR((unsigned long)layer_record_needed);
+			  SERIAL_ERRORPGM(" LAYER_REPLAY_MOVES: ");
+			  SERIAL_ERRORLN(LAYER_REPLAY_MOVES);
+			  break;
+		  case LAYER_RECORD_RASTER:
+			  SERIAL_ERROR_START;
+			  SERIAL_ERRORLNPGM("Layer not recorded: raster lines can't be replayed.");
+			  break;
+		  case LAYER_RECORD_HATCH:
+			  SERIAL_ERROR_START;
+			  SERIAL_ERRORLNPGM("Layer not recorded: the hatch polygon changed after its fill.");
+			  break;
+	  }
+  }
+
+  /**
+   * M669: Replay the recorded layer
+   *
+   *  S<passes>  Times over (default 1)
+   *
+   * The moves are cut into galvo segments again like any other, then a
+   * laser-off move goes back to where the head was. Changing the hatch
+   * polygon drops a recorded layer that fills it.
+   */
+  inline void gcode_M669() {
+	  if (layer_recording || !layer_record_count) {
+		  SERIAL_ERROR_START;
+		  SERIAL_ERRORLNPGM("No layer recorded.");
+		  return;
+	  }
+	  int passes = code_seen('S') ? code_value_short() : 1;
+	  if (passes <= 0) return;
+	  float back[2] = { current_position[X_AXIS], current_position[Y_AXIS] }, saved_feedrate = feedrate, values[2], mm_s;
+	  for (uint8_t pass = min(passes, 255); pass--;) {
+		  for (uint16_t i = 0; i < layer_record_count;) {
+			  switch (plan_recorded_move(i, values, mm_s)) {
+				  case LAYER_REPLAY_FEEDRATE:
+					  feedrate = mm_s * 60;
+					  break;
+				  case LAYER_REPLAY_MARK:
+					  laser_mark_to(values);
+					  break;
+				  case LAYER_REPLAY_TRAVEL:
+					  set_destination_to_current();
+					  destination[X_AXIS] = values[X_AXIS];
+					  destination[Y_AXIS] = values[Y_AXIS];
+					  prepare_move();
+					  break;
+				  #ifdef LASER_HATCH
+					  case LAYER_REPLAY_HATCH:
+						  hatch_fill(values[0], values[1]);
+						  break;
+				  #endif
+			  }
+		  }
 	  }
+	  set_destination_to_current();
+	  destination[X_AXIS] = back[X_AXIS];
+	  destination[Y_AXIS] = back[Y_AXIS];
+	  feedrate = max_feedrate[X_AXIS] * 60;
+	  prepare_move();
+	  feedrate = saved_feedrate;
   }
 #endif
+
+#ifndef AT90USB
+  /**
+   * M680: Serial receive counts
+   *
+   *  R  Clear the counts after reporting them
+   *
+   * Reports "O<overruns> D<dropped> A<available>": bytes the UART lost
+   * because it wasn't read in time, bytes thrown away with the receive ring
+   * full, and bytes waiting in the ring.
+   */
+  inline void gcode_M680() {
+	  bool clear = code_seen('R');
+	  CRITICAL_SECTION_START;
+	  uint16_t overruns = rx_overruns, dropped = rx_dropped;
+	  if (clear) rx_overruns = rx_dropped = 0;
+	  CRITICAL_SECTION_END;
+	  SERIAL_PROTOCOLPGM("O"); SERIAL_PROTOCOL(overruns);
+	  SERIAL_PROTOCOLPGM(" D"); SERIAL_PROTOCOL(dropped);
+	  SERIAL_PROTOCOLPGM(" A"); SERIAL_PROTOCOL(MYSERIAL.available());
+	  SERIAL_EOL;
+  }
+#endif
+
+#ifdef WINDOWED_OK
+  /**
+   * M691: Windowed ok
+   *
+   *  S1  Every ok reports "N<last line> P<planner> B<queue> R<receive>"
+   *  S0  Plain ok
+   *
+   * Reports the mode when given no parameters. The ok for M691 S1 is the
+   * first in the new form, and as the host waited for it, its R is the whole
+   * receive ring it can fill.
+   */
+  inline void gcode_M691() {
+	  if (code_seen('S')) {
+		  windowed_ok = code_value_short() == 1;
+		  windowed_resend = false;
+	  }
+	  else {
+		  SERIAL_ECHO_START;
+		  SERIAL_ECHOPAIR("Windowed ok S", (unsigned long)windowed_ok);
+		  SERIAL_EOL;
+	  }
+  }
+#endif
+
+#ifdef BINARY_PROTOCOL
+  /**
+   * M690: Binary motion frames
+   *
+   *  S1  Take binary frames (see binary_protocol.h) once this is answered
+   *  S0  Back to G-code
+   *
+   * Reports the mode when given no parameters.
+   */
+  inline void gcode_M690() {
+	  if (code_seen('S')) {
+		  binary_mode = code_value_short() == 1;
+		  binary_last_sequence = 0xFF;
+		  binary_resend = false;
+	  }
+	  else {
+		  SERIAL_ECHO_START;
+		  SERIAL_ECHOPAIR("Binary frames S", (unsigned long)binary_mode);
+		  SERIAL_EOL;
+	  }
+  }
+#endif
+
 /**
  * M907: Set digital trimpot motor current using axis codes X, Y, Z, E, B, S
  */
@@ -5482,8 +6347,86 @@ inline void gcode_T(uint8_t tmp_extruder) {
  * Process a single command and dispatch it to its handler
  * This is called from the main loop()
  */
+#ifdef BINARY_PROTOCOL
+
+  /**
+   * Read binary frames into the command queue. Frames are checked here, so
+   * only good frames in sequence are queued.
+   */
+  static void get_binary_frames() {
+    while (MYSERIAL.available() > 0 && (serial_count || command_queue_room())) {
+      uint8_t c = MYSERIAL.read();
+      uint8_t *frame = (uint8_t*)command_queue_text();
+      if (!serial_count) {
+        if (c == BINARY_ASCII) { binary_mode = false; return; }
+        if (c != BINARY_SYNC) continue; // Look for the start of a frame
+      }
+      frame[serial_count++] = c;
+      if (serial_count < BINARY_FRAME_SIZE) continue;
+      serial_count = 0;
+
+      uint8_t sequence = frame[1], expected = binary_last_sequence + 1;
+      bool good = binary_crc(frame + 1, BINARY_FRAME_SIZE - 3) == (frame[BINARY_FRAME_SIZE - 2] | (uint16_t)frame[BINARY_FRAME_SIZE - 1] << 8);
+      if (!good || sequence != expected) {
+        // Ask once, then drop frames already on their way
+        if (!good || !binary_resend) {
+          MYSERIAL.flush();
+          SERIAL_PROTOCOLPGM(MSG_RESEND);
+          SERIAL_PROTOCOLLN((int)expected);
+          binary_resend = true;
+        }
+        continue;
+      }
+      binary_resend = false;
+      binary_last_sequence = sequence;
+
+      command_queue_push(BINARY_FRAME_SIZE);
+    }
+  }
+
+  // Run a queued binary frame
+  static void process_binary_frame(const uint8_t *frame) {
+    union { float f[3]; long l[3]; } arg;
+    memcpy(&arg, frame + 3, sizeof(arg));
+    switch (frame[2]) {
+      case BINARY_OP_MOVE:
+      case BINARY_OP_MARK:
+        if (arg.f[2] > 0) feedrate = arg.f[2];
+        if (frame[2] == BINARY_OP_MARK)
+          laser_mark_to(arg.f);
+        else {
+          set_destination_to_current();
+          destination[X_AXIS] = arg.f[X_AXIS];
+          destination[Y_AXIS] = arg.f[Y_AXIS];
+          prepare_move();
+        }
+        break;
+      case BINARY_OP_DWELL: // Queued behind the moves, BINARY_OP_SYNC waits for them
+        if (arg.l[0] > 0) plan_buffer_dwell(arg.l[0]);
+        break;
+      case BINARY_OP_SYNC:
+        st_synchronize();
+        break;
+      default:
+        SERIAL_ERROR_START;
+        SERIAL_ERRORPGM("Unknown frame opcode ");
+        SERIAL_ERRORLN((int)frame[2]);
+        break;
+    }
+  }
+
+#endif // BINARY_PROTOCOL
+
 void process_next_command() {
-  current_command = command_queue[cmd_queue_index_r];
+  current_command = command_queue_first();
+
+  #ifdef BINARY_PROTOCOL
+    if (*current_command == (char)BINARY_SYNC) {
+      process_binary_frame((uint8_t*)current_command);
+      ok_to_send();
+      return;
+    }
+  #endif
 
   if ((marlin_debug_flags & DEBUG_ECHO)) {
     SERIAL_ECHO_START;
@@ -5521,8 +6464,9 @@ void process_next_command() {
   while (*current_command_args == ' ') ++current_command_args;
 
   // Interpret the code int
-  seen_pointer = current_command;
-  codenum = code_value_short();
+  codenum = (int16_t)code_read_long(current_command + 1);
+
+  parse_command_args();
 
   // Handle a known G, M, or T
   switch(command_code) {
@@ -5547,6 +6491,18 @@ void process_next_command() {
         gcode_G4();
         break;
 
+      #ifdef LASER_RASTER
+        case 7: // G7 Raster line
+          gcode_G7();
+          break;
+      #endif
+
+      #ifdef LASER_POLYLINE
+        case 8: // G8 Polyline
+          gcode_G8();
+          break;
+      #endif
+
       #ifdef FWRETRACT
 
         case 10: // G10: retract
@@ -5560,7 +6516,7 @@ void process_next_command() {
         gcode_G28();
         break;
 
-      #if defined(ENABLE_AUTO_BED_LEVELING) || defined(MESH_BED_LEVELING)
+      #if defined(ENABLE_AUTO_BED_LEVELING) || defined(MESH_BED_LEVELING) || defined(GALVO_CALIBRATION)
         case 29: // G29 Detailed Z-Probe, probes the bed at 3 or more points.
           gcode_G29();
           break;
@@ -5958,6 +6914,10 @@ void process_next_command() {
         case 421: // M421 Set a Mesh Bed Leveling Z coordinate
           gcode_M421();
           break;
+      #elif defined(GALVO_CALIBRATION)
+        case 420: // M420 Enable/Disable Galvo Calibration
+          gcode_M420();
+          break;
       #endif
 
       case 428: // M428 Apply current_position to home_offset
@@ -6010,6 +6970,74 @@ void process_next_command() {
 		case 655:
 			gcode_M655();
 			break;
+#endif
+#ifdef MUVE_Z_PEEL
+		case 652: // M652 Z peel
+			gcode_M652();
+			break;
+		case 653: // M653 Z peel settings
+			gcode_M653();
+			break;
+#endif
+#ifdef GALVO_JUMP_MODE
+		case 656: // M656 Galvo jump mode and settle table
+			gcode_M656();
+			break;
+#endif
+#ifdef LASER_DELAYS
+		case 657: // M657 Laser on, off and polygon delays
+			gcode_M657();
+			break;
+#endif
+#ifdef LASER_VELOCITY_POWER
+		case 659: // M659 Velocity-proportional laser power
+			gcode_M659();
+			break;
+#endif
+#ifdef LASER_LAYER_STATS
+		case 663: // M663 Layer marker
+			gcode_M663();
+			break;
+		case 664: // M664 Layer report
+			gcode_M664();
+			break;
+#endif
+#ifdef LASER_HATCH
+		case 660: // M660 Clear the hatch polygon
+			gcode_M660();
+			break;
+		case 661: // M661 Add a hatch polygon vertex
+			gcode_M661();
+			break;
+		case 662: // M662 Hatch fill the polygon
+			gcode_M662();
+			break;
+#endif
+#ifdef LASER_LAYER_REPLAY
+		case 667: // M667 Start recording a layer
+			gcode_M667();
+			break;
+		case 668: // M668 Stop recording a layer
+			gcode_M668();
+			break;
+		case 669: // M669 Replay the recorded layer
+			gcode_M669();
+			break;
+#endif
+#ifndef AT90USB
+		case 680: // M680 Serial receive counts
+			gcode_M680();
+			break;
+#endif
+#ifdef BINARY_PROTOCOL
+		case 690: // M690 Binary motion frames
+			gcode_M690();
+			break;
+#endif
+#ifdef WINDOWED_OK
+		case 691: // M691 Windowed ok
+			gcode_M691();
+			break;
 #endif
       case 907: // M907 Set digital trimpot motor current using axis codes.
         gcode_M907();
@@ -6058,6 +7086,12 @@ ExitUnknownCommand:
 
 void FlushSerialRequestResend() {
   //char command_queue[cmd_queue_index_r][100]="Resend:";
+  #ifdef WINDOWED_OK
+    // Lines already on their way are dropped as they come in
+    if (windowed_ok)
+      windowed_resend = true;
+    else
+  #endif
   MYSERIAL.flush();
   SERIAL_PROTOCOLPGM(MSG_RESEND);
   SERIAL_PROTOCOLLN(gcode_LastN + 1);
@@ -6067,13 +7101,23 @@ void FlushSerialRequestResend() {
 void ok_to_send() {
   refresh_cmd_timeout();
   #ifdef SDSUPPORT
-    if (fromsd[cmd_queue_index_r]) return;
+    if (commands_in_queue && (command_queue_header() & COMMAND_FROM_SD)) return;
   #endif
   SERIAL_PROTOCOLPGM(MSG_OK);
   #ifdef ADVANCED_OK
     SERIAL_PROTOCOLPGM(" N"); SERIAL_PROTOCOL(gcode_LastN);
     SERIAL_PROTOCOLPGM(" P"); SERIAL_PROTOCOL(int(BLOCK_BUFFER_SIZE - movesplanned() - 1));
-    SERIAL_PROTOCOLPGM(" B"); SERIAL_PROTOCOL(BUFSIZE - commands_in_queue);
+    SERIAL_PROTOCOLPGM(" B"); SERIAL_PROTOCOL(command_queue_free());
+  #endif
+  #ifdef WINDOWED_OK
+    if (windowed_ok) {
+      SERIAL_PROTOCOLPGM(" N"); SERIAL_PROTOCOL(gcode_LastN);
+      SERIAL_PROTOCOLPGM(" P"); SERIAL_PROTOCOL(int(BLOCK_BUFFER_SIZE - movesplanned() - 1));
+      SERIAL_PROTOCOLPGM(" B"); SERIAL_PROTOCOL(command_queue_free());
+      #ifndef AT90USB
+        SERIAL_PROTOCOLPGM(" R"); SERIAL_PROTOCOL(RX_BUFFER_SIZE - 1 - MYSERIAL.available());
+      #endif
+    }
   #endif
   SERIAL_EOL;  
 }
@@ -6314,19 +7358,44 @@ void mesh_plan_buffer_line(float x, float y, float z, const float e, float feed_
 // Code for doing real time mapping of print space to galvo space
 // in order to compensate for galvo calibration offsets
 #ifdef LASER
-  void calculate_galvo(float cartesian[3]) {
-	  galvo[X_AXIS] = cartesian[X_AXIS];
-	  galvo[Y_AXIS] = cartesian[Y_AXIS];
+  // Galvo position for a cartesian position moved by a calibration offset
+  static void calculate_galvo_offset(float cartesian[3], float dx, float dy) {
+	#ifdef GALVO_FIELD_CORRECTION
+	  galvo[X_AXIS] = galvo_correct(X_AXIS, cartesian[X_AXIS] + dx);
+	  galvo[Y_AXIS] = galvo_correct(Y_AXIS, cartesian[Y_AXIS] + dy);
+	#else
+	  galvo[X_AXIS] = cartesian[X_AXIS] + dx;
+	  galvo[Y_AXIS] = cartesian[Y_AXIS] + dy;
+	#endif
 	  galvo[Z_AXIS] = cartesian[Z_AXIS];
   }
 
+  void calculate_galvo(float cartesian[3]) {
+	#ifdef GALVO_CALIBRATION
+	  if (gmesh.active) {
+		  float offset[2];
+		  gmesh.get_offset(cartesian[X_AXIS], cartesian[Y_AXIS], offset);
+		  calculate_galvo_offset(cartesian, offset[X_AXIS], offset[Y_AXIS]);
+		  return;
+	  }
+	#endif
+	  calculate_galvo_offset(cartesian, 0, 0);
+  }
+
   inline bool prepare_move_laser() {
 	  float difference[NUM_AXIS];
 	  for (int8_t i=0; i < NUM_AXIS; i++) difference[i] = destination[i] - current_position[i];
 
 	  float cartesian_mm = sqrt(sq(difference[X_AXIS]) + sq(difference[Y_AXIS]));
-	  if (cartesian_mm < 0.000001) cartesian_mm = abs(difference[E_AXIS]);
-	  if (cartesian_mm < 0.000001) return false;
+	  if (cartesian_mm < 0.000001) {
+		  // No galvo motion, so nothing to segment
+		  calculate_galvo(destination);
+		  plan_buffer_line(galvo[X_AXIS], galvo[Y_AXIS], galvo[Z_AXIS], destination[E_AXIS], feedrate/60, active_extruder);
+		  return true;
+	  }
+	#ifdef LASER_LAYER_REPLAY
+	  record_layer_move(destination[X_AXIS], destination[Y_AXIS], destination[Z_AXIS], difference[E_AXIS] > 0);
+	#endif
 	  float seconds = 6000 * cartesian_mm / feedrate / feedrate_multiplier;
 	  int steps = max(1, int(laser_segments_per_second * seconds));
 
@@ -6334,6 +7403,12 @@ void mesh_plan_buffer_line(float x, float y, float z, const float e, float feed_
 	  // SERIAL_ECHOPGM(" seconds="); SERIAL_ECHO(seconds);
 	  // SERIAL_ECHOPGM(" steps="); SERIAL_ECHOLN(steps);
 
+	#ifdef GALVO_CALIBRATION
+	  // The segments are evenly spaced, so the mesh offsets can be stepped along the line
+	  if (gmesh.active)
+		  gmesh.walk_start(current_position[X_AXIS], current_position[Y_AXIS], difference[X_AXIS] / steps, difference[Y_AXIS] / steps);
+	#endif
+
 	  for (int s = 1; s <= steps; s++) {
 
 		  float fraction = float(s) / float(steps);
@@ -6341,7 +7416,15 @@ void mesh_plan_buffer_line(float x, float y, float z, const float e, float feed_
 		  for (int8_t i = 0; i < NUM_AXIS; i++)
 			  destination[i] = current_position[i] + difference[i] * fraction;
 
-		  calculate_galvo(destination);
+		#ifdef GALVO_CALIBRATION
+		  if (gmesh.active) {
+			  float offset[2];
+			  gmesh.walk_next(offset);
+			  calculate_galvo_offset(destination, offset[X_AXIS], offset[Y_AXIS]);
+		  }
+		  else
+		#endif
+			  calculate_galvo(destination);
 
 		  //SERIAL_ECHOPGM("destination[X_AXIS]="); SERIAL_ECHOLN(destination[X_AXIS]);
 		  //SERIAL_ECHOPGM("destination[Y_AXIS]="); SERIAL_ECHOLN(destination[Y_AXIS]);
@@ -6443,12 +7526,9 @@ void prepare_move() {
   #ifdef DUAL_X_CARRIAGE
     if (!prepare_move_dual_x_carriage()) return;
   #endif
-	/**
 #ifdef LASER
 	if (!prepare_move_laser()) return;
-#endif
-	**/
-#if !defined(DELTA) && !defined(SCARA)// && !defined(LASER)
+#elif !defined(DELTA) && !defined(SCARA)
     if (!prepare_move_cartesian()) return;
   #endif
 
@@ -6643,7 +7723,7 @@ void manage_inactivity(bool ignore_stepper_queue/*=false*/) {
       filrunout();
   #endif
 
-  if (commands_in_queue < BUFSIZE - 1) get_command();
+  get_command();
 
   millis_t ms = millis();
 
@@ -13,6 +13,34 @@
     #error You cannot have dual stepper drivers for both Y and Z.
   #endif
 
+  /**
+   * Serial rings
+   */
+  #if defined(RX_BUFFER_SIZE) && (RX_BUFFER_SIZE > 256 || (RX_BUFFER_SIZE & (RX_BUFFER_SIZE - 1)))
+    #error RX_BUFFER_SIZE must be a power of 2, up to 256.
+  #endif
+  #if defined(TX_BUFFER_SIZE) && (TX_BUFFER_SIZE > 256 || (TX_BUFFER_SIZE & (TX_BUFFER_SIZE - 1)))
+    #error TX_BUFFER_SIZE must be 0 or a power of 2, up to 256.
+  #endif
+
+  /**
+   * Command arguments are indexed with a byte, and a queued command's
+   * length shares its header byte with the SD flag
+   */
+  #if MAX_CMD_SIZE > 127
+    #error MAX_CMD_SIZE must be 127 or less.
+  #endif
+  #if defined(CMD_QUEUE_SIZE) && CMD_QUEUE_SIZE < 2 * (MAX_CMD_SIZE + 1)
+    #error CMD_QUEUE_SIZE must hold at least two of the longest commands.
+  #endif
+
+  /**
+   * Windowed ok reports what ADVANCED_OK does, and more
+   */
+  #if defined(WINDOWED_OK) && defined(ADVANCED_OK)
+    #error WINDOWED_OK and ADVANCED_OK cannot be used together.
+  #endif
+
   /**
    * Progress Bar
    */
@@ -106,6 +134,156 @@
     #endif
   #endif
 
+  /**
+   * Laser galvos
+   */
+  #ifdef GALVO_TIMED_MOTION
+    #ifndef LASER
+      #error GALVO_TIMED_MOTION requires LASER.
+    #endif
+    #if GALVO_UPDATE_RATE < 50 || GALVO_UPDATE_RATE > 40000
+      #error GALVO_UPDATE_RATE must be between 50 and 40000.
+    #endif
+  #endif
+  #ifdef GALVO_ASYNC_DAC
+    #ifndef LASER
+      #error GALVO_ASYNC_DAC requires LASER.
+    #endif
+    #ifdef SDSUPPORT
+      #error GALVO_ASYNC_DAC cannot share the SPI bus with SDSUPPORT.
+    #endif
+  #endif
+  #if defined(GALVO_DAC_LATCH) && !defined(LASER)
+    #error GALVO_DAC_LATCH requires LASER.
+  #endif
+  #if defined(GALVO_FIELD_CORRECTION) && !defined(LASER)
+    #error GALVO_FIELD_CORRECTION requires LASER.
+  #endif
+  #if defined(GALVO_JUMP_MODE) && !defined(LASER)
+    #error GALVO_JUMP_MODE requires LASER.
+  #endif
+  #if defined(GALVO_JUMP_MODE) && !defined(GALVO_TIMED_MOTION)
+    #error GALVO_JUMP_MODE requires GALVO_TIMED_MOTION.
+  #endif
+  #ifdef LASER
+    #if defined(ADVANCE) || defined(BARICUDA)
+      #error The compact laser block_t has no room for ADVANCE or BARICUDA.
+    #endif
+  #endif
+  #if defined(LASER_RASTER) && !defined(GALVO_TIMED_MOTION)
+    #error LASER_RASTER requires GALVO_TIMED_MOTION.
+  #endif
+  #ifdef LASER_HATCH
+    #if !defined(LASER) || !defined(LASER_EXTRUDER)
+      #error LASER_HATCH requires LASER and LASER_EXTRUDER.
+    #elif HATCH_MAX_VERTICES > 255
+      #error HATCH_MAX_VERTICES must be 255 or less.
+    #endif
+  #endif
+  #if defined(LASER_POLYLINE) && (!defined(LASER) || !defined(LASER_EXTRUDER))
+    #error LASER_POLYLINE requires LASER and LASER_EXTRUDER.
+  #endif
+  #if defined(BINARY_PROTOCOL) && (!defined(LASER) || !defined(LASER_EXTRUDER))
+    #error BINARY_PROTOCOL requires LASER and LASER_EXTRUDER.
+  #endif
+  #ifdef LASER_LAYER_REPLAY
+    #if !defined(LASER) || !defined(LASER_EXTRUDER)
+      #error LASER_LAYER_REPLAY requires LASER and LASER_EXTRUDER.
+    #elif LAYER_REPLAY_MOVES < 2 || LAYER_REPLAY_MOVES > 65535
+      #error LAYER_REPLAY_MOVES must be from 2 to 65535.
+    #endif
+  #endif
+  #if defined(BINARY_PROTOCOL) && !defined(GALVO_TIMED_MOTION)
+    #error BINARY_PROTOCOL requires GALVO_TIMED_MOTION.
+  #endif
+  #if defined(BINARY_PROTOCOL) && MAX_CMD_SIZE < 17
+    #error BINARY_PROTOCOL needs MAX_CMD_SIZE of 17 or more.
+  #endif
+  #ifdef LASER_PULSED
+    #if !defined(LASER) || LASER_CONTROL != 1 || !defined(GALVO_TIMED_MOTION)
+      #error LASER_PULSED requires LASER with LASER_CONTROL 1 and GALVO_TIMED_MOTION.
+    #elif defined(LASER_DELAYS)
+      #error LASER_PULSED cannot be used with LASER_DELAYS.
+    #endif
+  #endif
+  #if defined(LASER_VELOCITY_POWER) && (!defined(LASER) || LASER_CONTROL != 3 || !defined(GALVO_TIMED_MOTION))
+    #error LASER_VELOCITY_POWER requires LASER with LASER_CONTROL 3 and GALVO_TIMED_MOTION.
+  #endif
+  #if defined(LASER_LAYER_STATS) && !defined(LASER)
+    #error LASER_LAYER_STATS requires LASER.
+  #endif
+  #if defined(MUVE_Z_PEEL) && (!defined(LASER) || !defined(GALVO_TIMED_MOTION))
+    #error MUVE_Z_PEEL requires LASER and GALVO_TIMED_MOTION.
+  #endif
+  #if defined(GALVO_KINEMATICS) && !defined(GALVO_TIMED_MOTION)
+    #error GALVO_KINEMATICS requires GALVO_TIMED_MOTION.
+  #endif
+  #ifdef LASER_DELAYS
+    #if !defined(LASER) || LASER_CONTROL != 1
+      #error LASER_DELAYS requires LASER with LASER_CONTROL 1.
+    #endif
+    #if LASER_ON_DELAY > 30000 || LASER_OFF_DELAY > 30000 || LASER_POLYGON_DELAY > 30000
+      #error LASER_ON_DELAY, LASER_OFF_DELAY and LASER_POLYGON_DELAY cannot exceed 30000.
+    #endif
+  #endif
+  #ifdef GALVO_CALIBRATION
+    #ifndef LASER
+      #error GALVO_CALIBRATION requires LASER.
+    #endif
+    #ifdef MESH_BED_LEVELING
+      #error Select GALVO_CALIBRATION or MESH_BED_LEVELING, not both.
+    #endif
+    #if MESH_NUM_X_POINTS < 2 || MESH_NUM_Y_POINTS < 2 || MESH_NUM_X_POINTS > 7 || MESH_NUM_Y_POINTS > 7
+      #error MESH_NUM_X_POINTS and MESH_NUM_Y_POINTS must be from 2 to 7.
+    #endif
+  #endif
+
+  /**
+   * Static RAM of a laser build on the ATmega1280/2560. The sizes are from
+   * LinuxAddons/bin/laser_ram_report. LASER_RAM_FIXED is everything not
+   * listed here with every laser option on. The stack reserve covers M669
+   * replaying a hatch fill down into plan_buffer_line, with the stepper and
+   * serial interrupts on top; M662's edge list is counted with the hatch.
+   */
+  #if defined(LASER) && (defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__))
+    #define LASER_RAM_FIXED 1566
+    #define LASER_STACK_RESERVE 768
+    #ifdef LASER_DELAYS
+      #define LASER_RAM_BLOCK 95
+    #else
+      #define LASER_RAM_BLOCK 91
+    #endif
+    #ifdef LASER_HATCH
+      #define LASER_RAM_HATCH (HATCH_MAX_VERTICES * 5 + 33)
+    #else
+      #define LASER_RAM_HATCH 0
+    #endif
+    #ifdef LASER_LAYER_REPLAY
+      #define LASER_RAM_REPLAY (LAYER_REPLAY_MOVES * 4)
+    #else
+      #define LASER_RAM_REPLAY 0
+    #endif
+    #ifdef LASER_RASTER
+      #define LASER_RAM_RASTER 256
+    #else
+      #define LASER_RAM_RASTER 0
+    #endif
+    #ifdef GALVO_CALIBRATION
+      #define LASER_RAM_MESH (MESH_NUM_X_POINTS * MESH_NUM_Y_POINTS * 8 + 59)
+    #else
+      #define LASER_RAM_MESH 0
+    #endif
+    #ifdef GALVO_FIELD_CORRECTION
+      #define LASER_RAM_CORRECTION 260
+    #else
+      #define LASER_RAM_CORRECTION 0
+    #endif
+    #if LASER_RAM_FIXED + BLOCK_BUFFER_SIZE * LASER_RAM_BLOCK + BUFSIZE * MAX_CMD_SIZE + RX_BUFFER_SIZE + 2 + TX_BUFFER_SIZE + 2 \
+        + LASER_RAM_HATCH + LASER_RAM_REPLAY + LASER_RAM_RASTER + LASER_RAM_MESH + LASER_RAM_CORRECTION + LASER_STACK_RESERVE > 8192
+      #error The buffers leave too little RAM for the stack. Lower LAYER_REPLAY_MOVES, HATCH_MAX_VERTICES or BLOCK_BUFFER_SIZE.
+    #endif
+  #endif
+
   /**
    * Auto Bed Leveling
    */
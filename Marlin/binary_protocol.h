@@ -0,0 +1,45 @@
+/**
+ * binary_protocol.h - Binary motion frames (M690)
+ *
+ * After M690 S1 is answered, the host sends fixed-size frames instead of
+ * G-code lines. A frame goes through the command queue like a line, but
+ * needs no parsing and its payload goes straight to the planner.
+ *
+ *   0      BINARY_SYNC
+ *   1      Sequence number. 0 for the first frame after M690 S1, then one
+ *          more each frame, wrapping at 255.
+ *   2      Opcode
+ *   3-14   Payload: three little-endian floats (or longs, as noted)
+ *   15-16  CRC of bytes 1-14, low byte first
+ *
+ * The CRC is CRC-16/MCRF4XX (avr-libc's _crc_ccitt_update from 0xFFFF).
+ *
+ * Each frame is answered "ok" like a line. A bad CRC or a skipped sequence
+ * number is answered "Resend: <sequence>", with no ok, and frames are
+ * dropped until that one comes. A BINARY_ASCII byte in place of a frame
+ * goes back to G-code.
+ */
+
+#ifndef BINARY_PROTOCOL_H
+#define BINARY_PROTOCOL_H
+
+#define BINARY_SYNC       0xA5
+#define BINARY_ASCII      0x1B // ESC
+#define BINARY_FRAME_SIZE 17
+
+#define BINARY_OP_MOVE    1 // X, Y, feedrate (mm/min, 0 keeps the last). Laser off.
+#define BINARY_OP_MARK    2 // X, Y, feedrate. Laser on.
+#define BINARY_OP_DWELL   3 // Milliseconds (long), queued behind the moves like M652's pause
+#define BINARY_OP_SYNC    4 // Finish all moves before the ok
+
+FORCE_INLINE uint16_t binary_crc(const uint8_t *data, uint8_t length) {
+  uint16_t crc = 0xFFFF;
+  while (length--) {
+    uint8_t b = *data++ ^ (crc & 0xFF);
+    b ^= b << 4;
+    crc = (((uint16_t)b << 8) | (crc >> 8)) ^ (uint8_t)(b >> 4) ^ ((uint16_t)b << 3);
+  }
+  return crc;
+}
+
+#endif // BINARY_PROTOCOL_H
@@ -14,7 +14,7 @@
  *
  */
 
-#define EEPROM_VERSION "V20"
+#define EEPROM_VERSION "V23"
 
 /**
  * V19 EEPROM Layout:
@@ -87,6 +87,23 @@
  * Z_DUAL_ENDSTOPS:
  *  M666 Z    z_endstop_adj
  *
+ * GALVO_CALIBRATION:
+ *  M420 S    active
+ *            mesh_num_x (set in firmware, 0 if disabled)
+ *            mesh_num_y (set in firmware, 0 if disabled)
+ *  G29 S3    x_offsets[][]
+ *  G29 S3    y_offsets[][]
+ *
+ * GALVO_JUMP_MODE:
+ *  M656 S    galvo_jump_enabled
+ *  M656 P L  galvo_jump_length (x4)
+ *  M656 P D  galvo_jump_delay (x4)
+ *
+ * LASER_DELAYS:
+ *  M657 O    laser_on_delay
+ *  M657 F    laser_off_delay
+ *  M657 P    laser_polygon_delay
+ *
  */
 #include "Marlin.h"
 #include "language.h"
@@ -99,6 +116,10 @@
   #include "mesh_bed_leveling.h"
 #endif
 
+#ifdef GALVO_CALIBRATION
+  #include "galvo_mesh.h"
+#endif
+
 void _EEPROM_writeData(int &pos, uint8_t* value, uint8_t size) {
   uint8_t c;
   while(size--) {
@@ -276,6 +297,40 @@ void Config_StoreSettings()  {
     EEPROM_WRITE_VAR(i, dummy);
   }
 
+  #ifdef GALVO_CALIBRATION
+    // Compile time test that sizeof(gmesh.x_offsets) is as expected
+    typedef char g_assert[(sizeof(gmesh.x_offsets) == MESH_NUM_X_POINTS*MESH_NUM_Y_POINTS*sizeof(dummy)) ? 1 : -1];
+    uint8_t galvo_num_x = MESH_NUM_X_POINTS, galvo_num_y = MESH_NUM_Y_POINTS;
+    EEPROM_WRITE_VAR(i, gmesh.active);
+    EEPROM_WRITE_VAR(i, galvo_num_x);
+    EEPROM_WRITE_VAR(i, galvo_num_y);
+    EEPROM_WRITE_VAR(i, gmesh.x_offsets);
+    EEPROM_WRITE_VAR(i, gmesh.y_offsets);
+  #else
+    uint8_t galvo_dummy = 0; // Not active, and no points
+    for (int q = 3; q--;) EEPROM_WRITE_VAR(i, galvo_dummy);
+  #endif
+
+  #ifdef GALVO_JUMP_MODE
+    EEPROM_WRITE_VAR(i, galvo_jump_enabled);
+    EEPROM_WRITE_VAR(i, galvo_jump_length);
+    EEPROM_WRITE_VAR(i, galvo_jump_delay);
+  #else
+    bool galvo_jump_enabled = false;
+    EEPROM_WRITE_VAR(i, galvo_jump_enabled);
+    dummy = 0.0f;
+    for (int q = 8; q--;) EEPROM_WRITE_VAR(i, dummy);
+  #endif
+
+  #ifdef LASER_DELAYS
+    EEPROM_WRITE_VAR(i, laser_on_delay);
+    EEPROM_WRITE_VAR(i, laser_off_delay);
+    EEPROM_WRITE_VAR(i, laser_polygon_delay);
+  #else
+    unsigned int laser_delay = 0;
+    for (int q = 3; q--;) EEPROM_WRITE_VAR(i, laser_delay);
+  #endif
+
   char ver2[4] = EEPROM_VERSION;
   int j = EEPROM_OFFSET;
   EEPROM_WRITE_VAR(j, ver2); // validate data
@@ -444,6 +499,42 @@ void Config_RetrieveSettings() {
       if (q < EXTRUDERS) filament_size[q] = dummy;
     }
 
+    uint8_t galvo_active = 0, galvo_num_x = 0, galvo_num_y = 0;
+    EEPROM_READ_VAR(i, galvo_active);
+    EEPROM_READ_VAR(i, galvo_num_x);
+    EEPROM_READ_VAR(i, galvo_num_y);
+    #ifdef GALVO_CALIBRATION
+      if (galvo_num_x == MESH_NUM_X_POINTS && galvo_num_y == MESH_NUM_Y_POINTS) {
+        gmesh.active = galvo_active;
+        EEPROM_READ_VAR(i, gmesh.x_offsets);
+        EEPROM_READ_VAR(i, gmesh.y_offsets);
+      } else {
+        gmesh.reset();
+        for (int q = 0; q < 2 * galvo_num_x * galvo_num_y; q++) EEPROM_READ_VAR(i, dummy);
+      }
+    #else
+      for (int q = 0; q < 2 * galvo_num_x * galvo_num_y; q++) EEPROM_READ_VAR(i, dummy);
+    #endif // GALVO_CALIBRATION
+
+    #ifdef GALVO_JUMP_MODE
+      EEPROM_READ_VAR(i, galvo_jump_enabled);
+      EEPROM_READ_VAR(i, galvo_jump_length);
+      EEPROM_READ_VAR(i, galvo_jump_delay);
+    #else
+      bool galvo_jump_enabled;
+      EEPROM_READ_VAR(i, galvo_jump_enabled);
+      for (int q = 8; q--;) EEPROM_READ_VAR(i, dummy);
+    #endif
+
+    #ifdef LASER_DELAYS
+      EEPROM_READ_VAR(i, laser_on_delay);
+      EEPROM_READ_VAR(i, laser_off_delay);
+      EEPROM_READ_VAR(i, laser_polygon_delay);
+    #else
+      unsigned int laser_delay;
+      for (int q = 3; q--;) EEPROM_READ_VAR(i, laser_delay);
+    #endif
+
     calculate_volumetric_multipliers();
     // Call updatePID (similar to when we have processed M301)
 #ifndef LASER
@@ -499,6 +590,27 @@ void Config_ResetDefault() {
     mbl.active = 0;
   #endif
 
+  #ifdef GALVO_CALIBRATION
+    gmesh.active = 0;
+  #endif
+
+  #ifdef GALVO_JUMP_MODE
+    {
+      float jump_length[] = GALVO_JUMP_LENGTHS, jump_delay[] = GALVO_JUMP_DELAYS;
+      galvo_jump_enabled = true;
+      for (int q = 0; q < GALVO_JUMP_DELAY_POINTS; q++) {
+        galvo_jump_length[q] = jump_length[q];
+        galvo_jump_delay[q] = jump_delay[q];
+      }
+    }
+  #endif
+
+  #ifdef LASER_DELAYS
+    laser_on_delay = LASER_ON_DELAY;
+    laser_off_delay = LASER_OFF_DELAY;
+    laser_polygon_delay = LASER_POLYGON_DELAY;
+  #endif
+
   #ifdef ENABLE_AUTO_BED_LEVELING
     zprobe_zoffset = Z_PROBE_OFFSET_FROM_EXTRUDER;
   #endif
@@ -692,6 +804,54 @@ void Config_PrintSettings(bool forReplay) {
     }
   #endif
 
+  #ifdef GALVO_CALIBRATION
+    if (!forReplay) {
+      SERIAL_ECHOLNPGM("Galvo calibration:");
+      CONFIG_ECHO_START;
+    }
+    SERIAL_ECHOPAIR("  M420 S", (unsigned long)gmesh.active);
+    SERIAL_EOL;
+    for (int y=0; y<MESH_NUM_Y_POINTS; y++) {
+      for (int x=0; x<MESH_NUM_X_POINTS; x++) {
+        CONFIG_ECHO_START;
+        SERIAL_ECHOPAIR("  G29 S3 I", (unsigned long)(x + 1));
+        SERIAL_ECHOPAIR(" J", (unsigned long)(y + 1));
+        SERIAL_ECHOPAIR(" X", gmesh.x_offsets[y][x]);
+        SERIAL_ECHOPAIR(" Y", gmesh.y_offsets[y][x]);
+        SERIAL_EOL;
+      }
+    }
+  #endif
+
+  #ifdef GALVO_JUMP_MODE
+    CONFIG_ECHO_START;
+    if (!forReplay) {
+      SERIAL_ECHOLNPGM("Galvo jumps (mm, us):");
+      CONFIG_ECHO_START;
+    }
+    SERIAL_ECHOPAIR("  M656 S", (unsigned long)galvo_jump_enabled);
+    SERIAL_EOL;
+    for (int q = 0; q < GALVO_JUMP_DELAY_POINTS; q++) {
+      CONFIG_ECHO_START;
+      SERIAL_ECHOPAIR("  M656 P", (unsigned long)q);
+      SERIAL_ECHOPAIR(" L", galvo_jump_length[q]);
+      SERIAL_ECHOPAIR(" D", galvo_jump_delay[q]);
+      SERIAL_EOL;
+    }
+  #endif
+
+  #ifdef LASER_DELAYS
+    CONFIG_ECHO_START;
+    if (!forReplay) {
+      SERIAL_ECHOLNPGM("Laser delays (us):");
+      CONFIG_ECHO_START;
+    }
+    SERIAL_ECHOPAIR("  M657 O", (unsigned long)laser_on_delay);
+    SERIAL_ECHOPAIR(" F", (unsigned long)laser_off_delay);
+    SERIAL_ECHOPAIR(" P", (unsigned long)laser_polygon_delay);
+    SERIAL_EOL;
+  #endif
+
   #ifdef DELTA
     CONFIG_ECHO_START;
     if (!forReplay) {
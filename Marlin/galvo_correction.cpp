@@ -0,0 +1,49 @@
+/**
+ * galvo_correction.cpp - Galvo field (tangent) correction
+ */
+
+#include "galvo_correction.h"
+
+#ifdef GALVO_FIELD_CORRECTION
+
+  static const float field_min[2] = { X_MIN_POS, Y_MIN_POS };
+  static const float field_half[2] = { X_MAX_LENGTH / 2.0, Y_MAX_LENGTH / 2.0 };
+
+  // Normalized corrected offset from the field center (0..65535) at each
+  // segment boundary, from the center out to the edge of the field
+  static uint16_t correction_table[2][GALVO_CORRECTION_SEGMENTS + 1];
+
+  void galvo_correction_init(float res_distance) {
+    for (uint8_t axis = X_AXIS; axis <= Y_AXIS; axis++) {
+      float ratio = field_half[axis] / res_distance,
+            edge = atan(ratio);
+      for (uint8_t i = 0; i <= GALVO_CORRECTION_SEGMENTS; i++)
+        correction_table[axis][i] = lround(65535.0 * atan(ratio * i / GALVO_CORRECTION_SEGMENTS) / edge);
+    }
+  }
+
+  float galvo_correct(uint8_t axis, float position) {
+    float offset = position - field_min[axis] - field_half[axis];
+    bool negative = offset < 0;
+    if (negative) offset = -offset;
+
+    // The edge maps to itself, so beyond it (homing moves) there's nothing to correct
+    if (offset >= field_half[axis]) return position;
+
+    // Offset in 1/65536ths of half the field
+    long u = offset * 65536.0 / field_half[axis];
+    NOMORE(u, 65535);
+
+    // Segment index in the high word, position within the segment in the low word
+    u *= GALVO_CORRECTION_SEGMENTS;
+    uint8_t i = u >> 16;
+    uint16_t fract = u,
+             lo = correction_table[axis][i],
+             hi = correction_table[axis][i + 1];
+    uint16_t corrected = lo + (((uint32_t)(hi - lo) * fract) >> 16);
+
+    float corrected_offset = field_half[axis] * corrected / 65535.0;
+    return field_min[axis] + field_half[axis] + (negative ? -corrected_offset : corrected_offset);
+  }
+
+#endif // GALVO_FIELD_CORRECTION
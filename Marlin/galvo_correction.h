@@ -0,0 +1,30 @@
+/**
+ * galvo_correction.h - Galvo field (tangent) correction
+ *
+ * A galvo mirror turns the beam by an angle, so the spot lands at
+ * res_distance * tan(angle) and a DAC that is linear in angle bows straight
+ * lines outwards. Positions are mapped through atan before they're planned,
+ * so the planner and the stepper interrupt work in corrected galvo space.
+ *
+ * The map is kept as a small interpolated table per axis, built from the
+ * reservoir distance at startup and whenever it's changed with M655 H.
+ */
+
+#ifndef GALVO_CORRECTION_H
+#define GALVO_CORRECTION_H
+
+#include "Marlin.h"
+
+#ifdef GALVO_FIELD_CORRECTION
+
+  #define GALVO_CORRECTION_SEGMENTS 64 // Table segments across half the field
+
+  // Build the correction tables for a reservoir distance in mm
+  void galvo_correction_init(float res_distance);
+
+  // Corrected position of an X or Y axis position, in mm
+  float galvo_correct(uint8_t axis, float position);
+
+#endif // GALVO_FIELD_CORRECTION
+
+#endif // GALVO_CORRECTION_H
@@ -0,0 +1,71 @@
+/**
+ * galvo_dac.cpp - Galvo DAC output stage
+ */
+
+#include "galvo_dac.h"
+
+#ifdef LASER
+
+  // Set up the DAC control pins. SPI itself is started by setup_galvos().
+  void galvo_dac_init() {
+    #if HAS_GALVO_LDAC
+      OUT_WRITE(GALVO_LDAC_PIN, HIGH);
+    #endif
+  }
+
+#endif // LASER
+
+#ifdef GALVO_ASYNC_DAC
+
+  volatile unsigned char galvo_dac_buffer[GALVO_DAC_BUFFER_SIZE];
+  volatile unsigned char galvo_dac_head = 0;
+  volatile unsigned char galvo_dac_tail = 0;
+  volatile bool galvo_dac_busy = false;
+
+  static unsigned char frame_byte; // Bytes of the current frame already sent
+  #ifdef GALVO_LDAC_PULSE
+    static unsigned char frame_command; // Command byte of the current frame
+  #endif
+
+  // Start shifting out the ring. The transfer complete interrupt takes it from here.
+  void galvo_dac_start() {
+    galvo_dac_busy = true;
+    frame_byte = 0;
+    #ifdef GALVO_LDAC_PULSE
+      frame_command = galvo_dac_buffer[galvo_dac_tail];
+    #endif
+    SPCR |= BIT(SPIE);
+    WRITE(GALVO_SS_PIN, LOW);
+    SPDR = galvo_dac_buffer[galvo_dac_tail];
+    galvo_dac_tail = GALVO_DAC_MOD(galvo_dac_tail + 1);
+  }
+
+  // The last byte is out: close the frame if it's done and send the next byte
+  void galvo_dac_next() {
+    if (++frame_byte == 3) {
+      WRITE(GALVO_SS_PIN, HIGH);
+      frame_byte = 0;
+      #ifdef GALVO_LDAC_PULSE
+        // Both input registers are loaded: latch them together
+        if (frame_command == GALVO_DAC_LATCH_FRAME) GALVO_LDAC_PULSE();
+      #endif
+    }
+    if (galvo_dac_head == galvo_dac_tail) {
+      // Nothing left to send. Give the bus back.
+      SPCR &= ~BIT(SPIE);
+      galvo_dac_busy = false;
+      return;
+    }
+    if (frame_byte == 0) {
+      WRITE(GALVO_SS_PIN, LOW);
+      #ifdef GALVO_LDAC_PULSE
+        frame_command = galvo_dac_buffer[galvo_dac_tail];
+      #endif
+    }
+    SPDR = galvo_dac_buffer[galvo_dac_tail];
+    galvo_dac_tail = GALVO_DAC_MOD(galvo_dac_tail + 1);
+  }
+
+  ISR(SPI_STC_vect) { galvo_dac_next(); }
+
+#endif // GALVO_ASYNC_DAC
@@ -0,0 +1,114 @@
+/**
+ * galvo_dac.h - Galvo DAC output stage
+ *
+ * Each DAC write is a 24 bit frame: a command/address byte followed by the
+ * 16 bit value, framed by GALVO_SS_PIN.
+ *
+ * With GALVO_DAC_LATCH both channels are loaded into their input registers
+ * and then latched together, either by pulsing GALVO_LDAC_PIN or by sending
+ * an "update all channels" frame.
+ *
+ * With GALVO_ASYNC_DAC the frames are queued in a small ring and shifted
+ * out by the SPI transfer complete interrupt, so the stepper interrupt never
+ * waits on the SPI bus. Otherwise each frame is sent before returning.
+ */
+
+#ifndef GALVO_DAC_H
+#define GALVO_DAC_H
+
+#include "Marlin.h"
+
+#ifdef LASER
+
+  #define GALVO_DAC_WRITE_INPUT  (0 << 4) // Write to a DAC input register only
+  #define GALVO_DAC_UPDATE       (1 << 4) // Latch the input register to the output
+  #define GALVO_DAC_WRITE_UPDATE (3 << 4) // Write to and update a DAC channel
+  #define GALVO_DAC_ALL_CHANNELS 0x0F
+
+  // The frame after which the LDAC pin is pulsed
+  #define GALVO_DAC_LATCH_FRAME (Y_AXIS | GALVO_DAC_WRITE_INPUT)
+
+  #if defined(GALVO_DAC_LATCH) && HAS_GALVO_LDAC
+    #define GALVO_LDAC_PULSE() do{ WRITE(GALVO_LDAC_PIN, LOW); WRITE(GALVO_LDAC_PIN, HIGH); }while(0)
+  #endif
+
+  #ifdef GALVO_ASYNC_DAC
+
+    #define GALVO_DAC_BUFFER_SIZE 16 // Bytes in the output ring. Must be a power of 2
+    #define GALVO_DAC_MOD(n) ((n) & (GALVO_DAC_BUFFER_SIZE - 1))
+
+    extern volatile unsigned char galvo_dac_buffer[GALVO_DAC_BUFFER_SIZE];
+    extern volatile unsigned char galvo_dac_head;
+    extern volatile unsigned char galvo_dac_tail;
+    extern volatile bool galvo_dac_busy;
+
+    void galvo_dac_start();
+    void galvo_dac_next();
+
+    FORCE_INLINE void galvo_dac_put(unsigned char c) {
+      unsigned char next = GALVO_DAC_MOD(galvo_dac_head + 1);
+      // Ring full: the bus is behind, so push a byte out by hand
+      while (next == galvo_dac_tail) {
+        while (!TEST(SPSR, SPIF));
+        galvo_dac_next();
+      }
+      galvo_dac_buffer[galvo_dac_head] = c;
+      galvo_dac_head = next;
+    }
+
+    /**
+     * Queue one frame for a DAC channel.
+     * Call with interrupts disabled, i.e. from the stepper interrupt.
+     */
+    FORCE_INLINE void galvo_dac_write(unsigned char command, unsigned short value) {
+      galvo_dac_put(command);
+      galvo_dac_put(value >> 8);
+      galvo_dac_put(value);
+      if (!galvo_dac_busy) galvo_dac_start();
+    }
+
+  #else // !GALVO_ASYNC_DAC
+
+    #define GALVO_SPI_WAIT() do{ asm volatile("nop"); while (!TEST(SPSR, SPIF)); }while(0)
+
+    // Send one frame to a DAC channel
+    FORCE_INLINE void galvo_dac_write(unsigned char command, unsigned short value) {
+      WRITE(GALVO_SS_PIN, LOW);
+      SPDR = command;
+      GALVO_SPI_WAIT();
+      SPDR = value >> 8;
+      GALVO_SPI_WAIT();
+      SPDR = value;
+      GALVO_SPI_WAIT();
+      WRITE(GALVO_SS_PIN, HIGH);
+      #ifdef GALVO_LDAC_PULSE
+        if (command == GALVO_DAC_LATCH_FRAME) GALVO_LDAC_PULSE();
+      #endif
+    }
+
+  #endif // !GALVO_ASYNC_DAC
+
+  // Set an axis galvo to a DAC position
+  FORCE_INLINE void galvo_dac_move(unsigned char axis, unsigned short value) {
+    galvo_dac_write(axis | GALVO_DAC_WRITE_UPDATE, value);
+  }
+
+  // Set both galvos to a DAC position. With GALVO_DAC_LATCH they move together.
+  FORCE_INLINE void galvo_dac_move_xy(unsigned short x, unsigned short y) {
+    #ifdef GALVO_DAC_LATCH
+      galvo_dac_write(X_AXIS | GALVO_DAC_WRITE_INPUT, x);
+      galvo_dac_write(GALVO_DAC_LATCH_FRAME, y);
+      #if !HAS_GALVO_LDAC
+        galvo_dac_write(GALVO_DAC_ALL_CHANNELS | GALVO_DAC_UPDATE, 0);
+      #endif
+    #else
+      galvo_dac_move(X_AXIS, x);
+      galvo_dac_move(Y_AXIS, y);
+    #endif
+  }
+
+  void galvo_dac_init();
+
+#endif // LASER
+
+#endif // GALVO_DAC_H
@@ -0,0 +1,85 @@
+#include "galvo_mesh.h"
+
+#ifdef GALVO_CALIBRATION
+
+  galvo_mesh gmesh;
+
+  galvo_mesh::galvo_mesh() { reset(); }
+
+  void galvo_mesh::reset() {
+    active = 0;
+    for (int y = 0; y < MESH_NUM_Y_POINTS; y++)
+      for (int x = 0; x < MESH_NUM_X_POINTS; x++)
+        x_offsets[y][x] = y_offsets[y][x] = 0;
+  }
+
+  void galvo_mesh::get_offset(float x, float y, float offset[2]) {
+    int ix = cell_x_index(x), iy = cell_y_index(y);
+    float u = (x - get_x(ix)) / MESH_X_DIST,
+          v = (y - get_y(iy)) / MESH_Y_DIST;
+    for (uint8_t a = X_AXIS; a <= Y_AXIS; a++) {
+      float (*z)[MESH_NUM_X_POINTS] = a == X_AXIS ? x_offsets : y_offsets;
+      float z0 = z[iy][ix] + (z[iy][ix + 1] - z[iy][ix]) * u,
+            z1 = z[iy + 1][ix] + (z[iy + 1][ix + 1] - z[iy + 1][ix]) * u;
+      offset[a] = z0 + (z1 - z0) * v;
+    }
+  }
+
+  void galvo_mesh::walk_start(float x, float y, float step_x, float step_y) {
+    walk_origin[X_AXIS] = x;
+    walk_origin[Y_AXIS] = y;
+    walk_step[X_AXIS] = step_x;
+    walk_step[Y_AXIS] = step_y;
+    walk_segment = 0;
+    walk_enter(x, y);
+  }
+
+  /**
+   * Set up the differences for the cell holding (x, y).
+   *
+   * In cell coordinates (u, v) an offset is A + B*u + C*v + D*u*v. Stepping
+   * (du, dv) per segment, the first difference at (u, v) is
+   * B*du + C*dv + D*(u*dv + v*du + du*dv) and the second is 2*D*du*dv.
+   */
+  void galvo_mesh::walk_enter(float x, float y) {
+    int ix = cell_x_index(x), iy = cell_y_index(y);
+    // Edge cells also cover everything off the mesh
+    walk_low[X_AXIS] = ix > 0 ? get_x(ix) : -INFINITY;
+    walk_high[X_AXIS] = ix < MESH_NUM_X_POINTS - 2 ? get_x(ix + 1) : INFINITY;
+    walk_low[Y_AXIS] = iy > 0 ? get_y(iy) : -INFINITY;
+    walk_high[Y_AXIS] = iy < MESH_NUM_Y_POINTS - 2 ? get_y(iy + 1) : INFINITY;
+    float u = (x - get_x(ix)) / MESH_X_DIST,
+          v = (y - get_y(iy)) / MESH_Y_DIST,
+          du = walk_step[X_AXIS] / MESH_X_DIST,
+          dv = walk_step[Y_AXIS] / MESH_Y_DIST;
+    for (uint8_t a = X_AXIS; a <= Y_AXIS; a++) {
+      float (*z)[MESH_NUM_X_POINTS] = a == X_AXIS ? x_offsets : y_offsets;
+      float A = z[iy][ix],
+            B = z[iy][ix + 1] - A,
+            C = z[iy + 1][ix] - A,
+            D = z[iy + 1][ix + 1] - z[iy][ix + 1] - C;
+      walk_value[a] = A + B * u + C * v + D * u * v;
+      walk_delta[a] = B * du + C * dv + D * (u * dv + v * du + du * dv);
+      walk_delta2[a] = 2 * D * du * dv;
+    }
+  }
+
+  void galvo_mesh::walk_next(float offset[2]) {
+    walk_segment++;
+    float x = walk_origin[X_AXIS] + walk_step[X_AXIS] * walk_segment,
+          y = walk_origin[Y_AXIS] + walk_step[Y_AXIS] * walk_segment;
+    if (x < walk_low[X_AXIS] || x >= walk_high[X_AXIS] || y < walk_low[Y_AXIS] || y >= walk_high[Y_AXIS]) {
+      // Crossed into another cell
+      walk_enter(x, y);
+    }
+    else {
+      for (uint8_t a = X_AXIS; a <= Y_AXIS; a++) {
+        walk_value[a] += walk_delta[a];
+        walk_delta[a] += walk_delta2[a];
+      }
+    }
+    offset[X_AXIS] = walk_value[X_AXIS];
+    offset[Y_AXIS] = walk_value[Y_AXIS];
+  }
+
+#endif // GALVO_CALIBRATION
@@ -0,0 +1,62 @@
+/**
+ * galvo_mesh.h - Galvo field calibration mesh
+ *
+ * Holds the X/Y offsets measured at each point of a regular grid over the
+ * galvo field. Positions between grid points get the bilinear blend of the
+ * surrounding cell.
+ *
+ * Moves are split into evenly spaced segments, and along a straight line a
+ * bilinear cell is a quadratic in the segment number. So walk_start() and
+ * walk_next() step the offsets with forward differences (two adds per axis)
+ * and only recompute when the walk crosses into another cell.
+ */
+
+#ifndef GALVO_MESH_H
+#define GALVO_MESH_H
+
+#include "Marlin.h"
+
+#ifdef GALVO_CALIBRATION
+
+  #define MESH_X_DIST ((MESH_MAX_X - MESH_MIN_X)/(MESH_NUM_X_POINTS - 1))
+  #define MESH_Y_DIST ((MESH_MAX_Y - MESH_MIN_Y)/(MESH_NUM_Y_POINTS - 1))
+
+  class galvo_mesh {
+  public:
+    uint8_t active;
+    float x_offsets[MESH_NUM_Y_POINTS][MESH_NUM_X_POINTS];
+    float y_offsets[MESH_NUM_Y_POINTS][MESH_NUM_X_POINTS];
+
+    galvo_mesh();
+
+    void reset();
+
+    float get_x(int i) { return MESH_MIN_X + MESH_X_DIST * i; }
+    float get_y(int i) { return MESH_MIN_Y + MESH_Y_DIST * i; }
+    void set_offset(int ix, int iy, float dx, float dy) { x_offsets[iy][ix] = dx; y_offsets[iy][ix] = dy; }
+
+    // The cell holding a position. Positions off the mesh use the edge cell.
+    int cell_x_index(float x) { return constrain((int)floor((x - MESH_MIN_X) / MESH_X_DIST), 0, MESH_NUM_X_POINTS - 2); }
+    int cell_y_index(float y) { return constrain((int)floor((y - MESH_MIN_Y) / MESH_Y_DIST), 0, MESH_NUM_Y_POINTS - 2); }
+
+    // X/Y offsets at a position
+    void get_offset(float x, float y, float offset[2]);
+
+    // Offsets along a line from (x, y), moving (step_x, step_y) per segment
+    void walk_start(float x, float y, float step_x, float step_y);
+    void walk_next(float offset[2]);
+
+  private:
+    float walk_origin[2], walk_step[2];
+    int walk_segment;
+    float walk_low[2], walk_high[2]; // Bounds of the current cell
+    float walk_value[2], walk_delta[2], walk_delta2[2]; // Offsets and their first and second differences
+
+    void walk_enter(float x, float y);
+  };
+
+  extern galvo_mesh gmesh;
+
+#endif // GALVO_CALIBRATION
+
+#endif // GALVO_MESH_H
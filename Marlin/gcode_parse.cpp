@@ -0,0 +1,138 @@
+/**
+ * gcode_parse.cpp - G-code numbers and arguments
+ */
+
+#include "gcode_parse.h"
+
+char *current_command_args;
+
+static char *seen_pointer; ///< A pointer to find chars in the command string (X, Y, Z, E, etc.)
+#define MAX_CODE_VALUES 8
+static uint8_t code_offset[26];  ///< 1 + position of each letter A-Z in the command arguments, 0 if it's not there
+static uint8_t code_slot[26];    ///< 1 + index of the letter's number in code_values, 0 if it wasn't read ahead
+static float code_values[MAX_CODE_VALUES]; ///< Numbers read by parse_command_args()
+static uint8_t seen_slot;        ///< code_slot of the letter code_seen() last found
+
+// Powers of ten that are exact as floats
+static const float code_pow10_P[] PROGMEM = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10 };
+
+/**
+ * Read a G-code number: spaces, a sign, digits and a fraction, with no
+ * exponent, so an E after the digits is left alone. While the digits stay under 2^24 and
+ * the fraction is 10 digits or less, the digits and the power of ten are
+ * exact floats, and one division gives the same correctly rounded value as
+ * strtod() at a fraction of the cost. Longer numbers still go to strtod().
+ */
+float code_read_float(char *p) {
+  while (*p == ' ' || *p == '\t') p++;
+  char *start = p;
+  bool negative = false;
+  if (*p == '-' || *p == '+') negative = (*p++ == '-');
+  uint32_t digits = 0;
+  uint8_t count = 0, fraction = 0;
+  bool point = false, exact = true;
+  for (;; p++) {
+    char c = *p;
+    if (c >= '0' && c <= '9') {
+      count++;
+      if (exact) {
+        digits = digits * 10 + (c - '0');
+        if (digits >= 0x1000000UL) exact = false;
+        if (point) fraction++;
+      }
+    }
+    else if (c == '.' && !point)
+      point = true;
+    else
+      break;
+  }
+  if (!count) return 0;
+  if (exact && fraction <= 10) {
+    float value = (float)digits;
+    if (fraction) value /= pgm_read_float_near(&code_pow10_P[fraction]);
+    return negative ? -value : value;
+  }
+  // End the number here so strtod() can't take what follows as an exponent
+  char c = *p;
+  *p = 0;
+  float value = strtod(start, NULL);
+  *p = c;
+  return value;
+}
+
+// Read a G-code integer: spaces, a sign and digits
+long code_read_long(const char *p) {
+  while (*p == ' ' || *p == '\t') p++;
+  bool negative = false;
+  if (*p == '-' || *p == '+') negative = (*p++ == '-');
+  long value = 0;
+  for (; *p >= '0' && *p <= '9'; p++) value = value * 10 + (*p - '0');
+  return negative ? -value : value;
+}
+
+bool code_has_value() {
+  int i = 1;
+  char c = seen_pointer[i];
+  while (c == ' ' || c == '\t') c = seen_pointer[++i];
+  if (c == '-' || c == '+') c = seen_pointer[++i];
+  if (c == '.') c = seen_pointer[++i];
+  return (c >= '0' && c <= '9');
+}
+
+float code_value() { return seen_slot ? code_values[seen_slot - 1] : code_read_float(seen_pointer + 1); }
+
+long code_value_long() { return code_read_long(seen_pointer + 1); }
+
+int16_t code_value_short() { return (int16_t)code_read_long(seen_pointer + 1); }
+
+/**
+ * Go over the command arguments once, noting where each letter first
+ * appears, and read the numbers of the words that start with one. After this
+ * code_seen() is a table lookup and code_value() mostly returns a number
+ * already read. Letters inside words (file names) are noted like strchr()
+ * would find them, but no number is read for them. Commands that end with
+ * data (G7, G8) cut it off with code_args_end() before looking for letters.
+ */
+void parse_command_args() {
+  memset(code_offset, 0, sizeof(code_offset));
+  uint8_t values = 0;
+  bool word_start = true;
+  for (char *p = current_command_args; *p; p++) {
+    uint8_t n = *p - 'A';
+    if (n < 26 && !code_offset[n]) {
+      code_offset[n] = p - current_command_args + 1;
+      code_slot[n] = 0;
+      seen_pointer = p;
+      if (word_start && values < MAX_CODE_VALUES && code_has_value()) {
+        code_values[values++] = code_read_float(p + 1);
+        code_slot[n] = values;
+      }
+    }
+    word_start = (*p == ' ');
+  }
+}
+
+bool code_seen(char code) {
+  uint8_t n = code - 'A';
+  if (n < 26) {
+    if (!code_offset[n]) return false;
+    seen_pointer = current_command_args + code_offset[n] - 1;
+    seen_slot = code_slot[n];
+    return true;
+  }
+  // Anything but a capital letter still takes a search
+  seen_pointer = strchr(current_command_args, code);
+  seen_slot = 0;
+  return (seen_pointer != NULL);  //Return True if a character was found
+}
+
+/**
+ * End the command arguments at p, for a command that takes the rest of the
+ * line as data, and forget the letters parse_command_args() noted in it.
+ */
+void code_args_end(char *p) {
+  *p = '\0';
+  uint8_t end = p - current_command_args + 1;
+  for (uint8_t n = 0; n < 26; n++)
+    if (code_offset[n] >= end) code_offset[n] = 0;
+}
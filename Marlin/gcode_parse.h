@@ -0,0 +1,36 @@
+/**
+ * gcode_parse.h - G-code numbers and arguments
+ *
+ * parse_command_args() goes over a command's arguments once, noting where
+ * each letter first appears and reading the numbers of the words that start
+ * with one, so code_seen() is a table lookup and code_value() mostly returns
+ * a number already read. Numbers are read without strtod() while the digits
+ * fit a float exactly.
+ */
+
+#ifndef GCODE_PARSE_H
+#define GCODE_PARSE_H
+
+#include "Marlin.h"
+
+extern char *current_command_args; ///< The command after its code (G1, M104, ...)
+
+// Read a G-code number: spaces, a sign, digits and a fraction, but no exponent
+float code_read_float(char *p);
+
+// Read a G-code integer: spaces, a sign and digits
+long code_read_long(const char *p);
+
+// Note the letters and read the numbers of current_command_args
+void parse_command_args();
+
+// End the arguments at p, for a command that takes the rest of the line as data
+void code_args_end(char *p);
+
+bool code_seen(char code);
+bool code_has_value();
+float code_value();
+long code_value_long();
+int16_t code_value_short();
+
+#endif // GCODE_PARSE_H
@@ -0,0 +1,56 @@
+#include "hatch.h"
+
+#ifdef LASER_HATCH
+
+  hatch_polygon hatch;
+
+  hatch_polygon::hatch_polygon() { clear(); set_angle(0); }
+
+  void hatch_polygon::clear() {
+    vertices = 0;
+    for (uint8_t i = 0; i < sizeof(contour_start); i++) contour_start[i] = 0;
+  }
+
+  bool hatch_polygon::add_vertex(float vx, float vy, bool new_contour) {
+    if (vertices >= HATCH_MAX_VERTICES || fabs(vx) > HATCH_MAX_MM || fabs(vy) > HATCH_MAX_MM) return false;
+    if (new_contour || !vertices) contour_start[vertices >> 3] |= BIT(vertices & 7);
+    x[vertices] = lround(vx * HATCH_UNITS);
+    y[vertices] = lround(vy * HATCH_UNITS);
+    vertices++;
+    return true;
+  }
+
+  void hatch_polygon::set_angle(float degrees) {
+    cos_angle = cos(RADIANS(degrees));
+    sin_angle = sin(RADIANS(degrees));
+    v_min = INFINITY;
+    v_max = -INFINITY;
+    for (uint8_t i = 0; i < vertices; i++) {
+      float v = get_v(i);
+      NOMORE(v_min, v);
+      NOLESS(v_max, v);
+    }
+  }
+
+  // Each contour closes back to its first vertex
+  uint8_t hatch_polygon::edge_end(uint8_t i) {
+    if (i + 1 < vertices && !starts_contour(i + 1)) return i + 1;
+    while (!starts_contour(i)) i--;
+    return i;
+  }
+
+  uint8_t hatch_polygon::crossings(float v, uint8_t edges[]) {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < vertices; i++) {
+      // Half-open, so a hatch line through a vertex counts it once
+      if ((get_v(i) <= v) == (get_v(edge_end(i)) <= v)) continue;
+      float c = crossing_u(i, v);
+      // Insertion sort, there are only a few crossings
+      uint8_t k = count++;
+      for (; k && crossing_u(edges[k - 1], v) > c; k--) edges[k] = edges[k - 1];
+      edges[k] = i;
+    }
+    return count;
+  }
+
+#endif // LASER_HATCH
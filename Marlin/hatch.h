@@ -0,0 +1,70 @@
+/**
+ * hatch.h - Hatch fill of polygon contours
+ *
+ * Holds the contours of a layer, uploaded with M660/M661, so the hatch lines
+ * can be worked out here instead of sent over serial one by one.
+ *
+ * Hatching runs in a frame turned by the hatch angle, where hatch lines are
+ * lines of constant v. crossings() gives the sorted u where a hatch line
+ * crosses the contour edges. Taken in pairs, these are the spans inside the
+ * polygon by the even-odd rule, so contours nested inside others are holes.
+ */
+
+#ifndef HATCH_H
+#define HATCH_H
+
+#include "Marlin.h"
+
+#ifdef LASER_HATCH
+
+  #define HATCH_UNITS 100                      // Vertices are kept to 0.01mm
+  #define HATCH_MAX_MM (32767 / HATCH_UNITS)
+
+  class hatch_polygon {
+  public:
+    uint8_t vertices;
+    float v_min, v_max; // Extent across the hatch lines, set by set_angle()
+
+    hatch_polygon();
+
+    void clear();
+
+    // Add a vertex to the last contour, or start a new contour with it.
+    // False if the buffer is full or the vertex is beyond +/-HATCH_MAX_MM.
+    bool add_vertex(float x, float y, bool new_contour);
+
+    void set_angle(float degrees);
+
+    // The edges the hatch line at v crosses, by their first vertex, sorted
+    // along the line. At most HATCH_MAX_VERTICES.
+    uint8_t crossings(float v, uint8_t edges[]);
+
+    // Where the hatch line at v crosses an edge
+    float crossing_u(uint8_t edge, float v) {
+      uint8_t j = edge_end(edge);
+      float ui = get_u(edge), vi = get_v(edge);
+      return ui + (get_u(j) - ui) * (v - vi) / (get_v(j) - vi);
+    }
+
+    // Back from the hatch frame to X/Y
+    void get_xy(float u, float v, float xy[2]) {
+      xy[X_AXIS] = u * cos_angle - v * sin_angle;
+      xy[Y_AXIS] = u * sin_angle + v * cos_angle;
+    }
+
+  private:
+    int16_t x[HATCH_MAX_VERTICES], y[HATCH_MAX_VERTICES]; // In 1/HATCH_UNITS mm
+    uint8_t contour_start[(HATCH_MAX_VERTICES + 7) / 8]; // Bit per vertex, set for the first of each contour
+    float cos_angle, sin_angle;
+
+    bool starts_contour(uint8_t i) { return TEST(contour_start[i >> 3], i & 7); }
+    uint8_t edge_end(uint8_t i);
+    float get_u(uint8_t i) { return (x[i] * cos_angle + y[i] * sin_angle) * (1.0 / HATCH_UNITS); }
+    float get_v(uint8_t i) { return (y[i] * cos_angle - x[i] * sin_angle) * (1.0 / HATCH_UNITS); }
+  };
+
+  extern hatch_polygon hatch;
+
+#endif // LASER_HATCH
+
+#endif // HATCH_H
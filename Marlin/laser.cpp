@@ -54,8 +54,13 @@ void laser_init()
 
   // Initialize state to sane defaults
   laser.intensity = 100.0;
-  laser.ppm = 10;
-  laser.duration = 1000;
+  #ifdef LASER_PULSED
+    laser.ppm = LASER_PPM;
+    laser.duration = LASER_PULSE_DURATION;
+  #else
+    laser.ppm = 10;
+    laser.duration = 1000;
+  #endif
   laser.status = LASER_OFF;
   laser.firing = LASER_OFF;
   #ifdef MUVE_Z_PEEL
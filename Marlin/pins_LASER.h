@@ -202,6 +202,7 @@
 //Open SL Pins
 #define GALVO_SS_PIN		61//
 #define LASER_FIRING_PIN	 32//
+#define GALVO_LDAC_PIN		-1 // Wire to the DAC LDAC input to latch both galvo channels without an update frame
 
   #define SCK_PIN          52
   #define MISO_PIN         50
@@ -89,6 +89,63 @@ unsigned long axis_steps_per_sqr_second[NUM_AXIS];
   };
 #endif // ENABLE_AUTO_BED_LEVELING
 
+#ifdef GALVO_JUMP_MODE
+  bool galvo_jump_enabled = true;
+  float galvo_jump_length[GALVO_JUMP_DELAY_POINTS] = GALVO_JUMP_LENGTHS;
+  float galvo_jump_delay[GALVO_JUMP_DELAY_POINTS] = GALVO_JUMP_DELAYS;
+#endif
+
+#ifdef GALVO_KINEMATICS
+  float galvo_max_speed[2];
+  float galvo_max_acceleration[2];
+  float galvo_max_dv;
+#endif
+
+#ifdef LASER_RASTER
+  uint8_t raster_buffer[RASTER_BUFFER_SIZE];
+  uint8_t raster_buffer_head;
+  volatile uint8_t raster_buffer_tail;
+  static uint8_t raster_pending; // Pixels waiting for the next planned block
+#endif
+
+#ifdef LASER_LAYER_REPLAY
+  // A move as asked for, before it's cut into galvo segments, or a change of
+  // feedrate. A hatch fill is a record followed by two raw value records.
+  typedef union {
+    struct {
+      uint16_t kind : 2;           // LAYER_REPLAY_TRAVEL, _MARK, _FEEDRATE or _HATCH
+      int16_t x : 14;              // Target in cartesian steps
+      int16_t y;                   // Target in cartesian steps, or feedrate in 1/LAYER_RECORD_SPEED_SCALE mm/sec
+    } move;
+    float value;                   // Hatch spacing or angle
+  } layer_record_t;
+
+  #define LAYER_RECORD_SPEED_SCALE 8
+  #define LAYER_RECORD_MAX_STEPS 8191
+
+  bool layer_recording;
+  uint16_t layer_record_count;
+  uint16_t layer_record_needed;
+  static uint8_t layer_record_status;
+  static int16_t layer_record_speed;    // Feedrate of the last record, 0 for none yet
+  static bool layer_record_hatches;     // The layer has a hatch fill
+  static layer_record_t layer_records[LAYER_REPLAY_MOVES];
+#endif
+
+#ifdef LASER_DELAYS
+  unsigned int laser_on_delay = LASER_ON_DELAY;
+  unsigned int laser_off_delay = LASER_OFF_DELAY;
+  unsigned int laser_polygon_delay = LASER_POLYGON_DELAY;
+#endif
+
+#ifdef LASER_VELOCITY_POWER
+  bool laser_velocity_power = true;
+#endif
+
+#ifdef LASER_LAYER_STATS
+  bool layer_start_pending;
+#endif
+
 #ifdef AUTOTEMP
   float autotemp_max = 250;
   float autotemp_min = 210;
@@ -112,6 +169,9 @@ volatile unsigned char block_buffer_tail;           // Index of the block to pro
 long position[NUM_AXIS];               // Rescaled from extern when axis_steps_per_unit are changed by gcode
 static float previous_speed[NUM_AXIS]; // Speed of previous path line segment
 static float previous_nominal_speed;   // Nominal speed of previous path line segment
+#ifdef LASER_DELAYS
+  static bool previous_laser_status;   // Laser state of the previous block
+#endif
 
 unsigned char g_uc_extruder_last_move[4] = {0,0,0,0};
 
@@ -154,9 +214,264 @@ FORCE_INLINE float intersection_distance(float initial_rate, float final_rate, f
   return (acceleration * 2 * distance - initial_rate * initial_rate + final_rate * final_rate) / (acceleration * 4);
 }
 
+#ifdef LASER
+
+  // DAC word for a position on the galvo step grid, clamped to the DAC range
+  FORCE_INLINE unsigned short galvo_dac_word(long grid_position) {
+    long dac = grid_position * (GRID_SCALAR);
+    NOLESS(dac, 0);
+    NOMORE(dac, 0xFFFF);
+    return dac;
+  }
+
+  // DAC change per step (16.16) that takes an axis from one DAC word to another
+  FORCE_INLINE long galvo_dac_step(unsigned short from, unsigned short to, unsigned long steps) {
+    if (!steps) return 0;
+    return lround(((long)to - (long)from) * 65536.0 / steps);
+  }
+
+#endif // LASER
+
+#ifdef GALVO_JUMP_MODE
+
+  // Settle time in Timer1 ticks after a jump, interpolated from the delay table
+  static unsigned short galvo_jump_settle_ticks(float length) {
+    float delay = galvo_jump_delay[0];
+    for (uint8_t i = 1; i < GALVO_JUMP_DELAY_POINTS; i++) {
+      if (length <= galvo_jump_length[i - 1]) break;
+      float span = galvo_jump_length[i] - galvo_jump_length[i - 1];
+      if (length < galvo_jump_length[i] && span > 0) {
+        delay += (galvo_jump_delay[i] - delay) * (length - galvo_jump_length[i - 1]) / span;
+        break;
+      }
+      delay = galvo_jump_delay[i];
+    }
+    NOMORE(delay, GALVO_JUMP_MAX_DELAY);
+    NOLESS(delay, 1);
+    return delay * (F_CPU / 8000000);
+  }
+
+#endif // GALVO_JUMP_MODE
+
+#ifdef GALVO_KINEMATICS
+
+  /**
+   * Translate the mirror limits into planner space.
+   *
+   * With field correction the planner works in units that are linear in beam
+   * angle. Without it a mm is the most angle at the center of the field, so
+   * the limits are taken there.
+   */
+  void galvo_kinematics_init(float res_distance) {
+    const float angular_velocity[2] = GALVO_MAX_ANGULAR_VELOCITY,
+                angular_acceleration[2] = GALVO_MAX_ANGULAR_ACCELERATION,
+                half_field[2] = { X_MAX_LENGTH / 2.0, Y_MAX_LENGTH / 2.0 },
+                response = 2 * M_PI * (GALVO_BANDWIDTH); // 1 / mirror time constant
+    for (uint8_t i = X_AXIS; i <= Y_AXIS; i++) {
+      #ifdef GALVO_FIELD_CORRECTION
+        float radians_per_mm = atan(half_field[i] / res_distance) / half_field[i];
+      #else
+        float radians_per_mm = 1 / res_distance;
+      #endif
+      galvo_max_speed[i] = RADIANS(angular_velocity[i]) / radians_per_mm;
+      galvo_max_acceleration[i] = RADIANS(angular_acceleration[i]) / radians_per_mm;
+    }
+    galvo_max_dv = (GALVO_CORNER_DEVIATION) * response;
+  }
+
+#endif // GALVO_KINEMATICS
+
+#ifdef GALVO_TIMED_MOTION
+
+  // The trapezoid of a timed galvo block, expressed in galvo updates. Each galvo
+  // integrates its own velocity, so the stepper interrupt only has to add to
+  // move along the line.
+  static void calculate_galvo_trapezoid(block_t *block, float entry_factor, float exit_factor) {
+    float accel = block->acceleration,
+          entry_speed = block->nominal_speed * entry_factor,
+          exit_speed = block->nominal_speed * exit_factor,
+          peak_speed = block->nominal_speed,
+          accelerate_mm = estimate_acceleration_distance(entry_speed, peak_speed, accel),
+          decelerate_mm = estimate_acceleration_distance(exit_speed, peak_speed, accel);
+    if (accelerate_mm + decelerate_mm > block->millimeters) {
+      // No plateau: accelerate to the speed where the two ramps meet
+      peak_speed = sqrt(accel * block->millimeters + (entry_speed * entry_speed + exit_speed * exit_speed) / 2);
+      accelerate_mm = estimate_acceleration_distance(entry_speed, peak_speed, accel);
+      decelerate_mm = block->millimeters - accelerate_mm;
+    }
+    float plateau_mm = block->millimeters - accelerate_mm - decelerate_mm;
+    NOLESS(plateau_mm, 0);
+
+    unsigned long accelerate_updates = accel > 0 ? lround((peak_speed - entry_speed) * GALVO_UPDATE_RATE / accel) : 0,
+                  plateau_updates = lround(plateau_mm * GALVO_UPDATE_RATE / peak_speed),
+                  decelerate_updates = accel > 0 ? lround((peak_speed - exit_speed) * GALVO_UPDATE_RATE / accel) : 0,
+                  galvo_accel_until = accelerate_updates,
+                  galvo_decel_after = accelerate_updates + plateau_updates,
+                  galvo_updates = galvo_decel_after + decelerate_updates;
+    NOLESS(galvo_updates, 1);
+
+    // DAC steps (16.16) per update for each mm/sec along the path
+    long galvo_rate[2], galvo_accel[2];
+    float per_speed = 65536.0 * (GRID_SCALAR) / GALVO_UPDATE_RATE / block->millimeters;
+    for (int i = X_AXIS; i <= Y_AXIS; i++) {
+      float axis_scale = block->steps[i] * per_speed;
+      if (TEST(block->direction_bits, i)) axis_scale = -axis_scale;
+      galvo_rate[i] = lround(entry_speed * axis_scale);
+      galvo_accel[i] = lround(accel * axis_scale / GALVO_UPDATE_RATE);
+    }
+
+    CRITICAL_SECTION_START;  // Fill variables used by the stepper in a critical section
+    if (!block->busy) { // Don't update variables if block is busy.
+      for (int i = X_AXIS; i <= Y_AXIS; i++) {
+        block->galvo_rate[i] = galvo_rate[i];
+        block->galvo_accel[i] = galvo_accel[i];
+      }
+      block->galvo_accel_until = galvo_accel_until;
+      block->galvo_decel_after = galvo_decel_after;
+      block->galvo_updates = galvo_updates;
+    }
+    CRITICAL_SECTION_END;
+  }
+
+#endif // GALVO_TIMED_MOTION
+
+#ifdef LASER_RASTER
+
+  void plan_raster_pixels(const uint8_t *pixels, uint8_t count) {
+    // Wait for the stepper to expose enough of the queued pixels
+    while ((uint8_t)(raster_buffer_head - raster_buffer_tail) > RASTER_BUFFER_SIZE - 1 - count) idle();
+    for (uint8_t i = 0; i < count; i++) raster_buffer[(uint8_t)(raster_buffer_head + i)] = pixels[i];
+    raster_pending = count;
+  }
+
+  float plan_raster_acceleration(const float direction[2]) {
+    float accel = 0;
+    for (uint8_t i = X_AXIS; i <= Y_AXIS; i++) {
+      float d = fabs(direction[i]);
+      if (d < 0.000001) continue;
+      #ifdef GALVO_KINEMATICS
+        float a = galvo_max_acceleration[i] / d;
+      #else
+        float a = min(travel_acceleration, max_acceleration_units_per_sq_second[i] / d);
+      #endif
+      if (!accel || a < accel) accel = a;
+    }
+    return accel;
+  }
+
+#endif // LASER_RASTER
+
+#ifdef LASER_LAYER_REPLAY
+
+  // The next free record, or NULL if the layer doesn't fit
+  static layer_record_t* layer_record_next() {
+    if (layer_record_needed < 0xFFFF) layer_record_needed++;
+    if (layer_record_count >= LAYER_REPLAY_MOVES) {
+      if (layer_record_status == LAYER_RECORD_OK) layer_record_status = LAYER_RECORD_FULL;
+      return NULL;
+    }
+    return &layer_records[layer_record_count++];
+  }
+
+  // A feedrate record, if the speed changed since the last one
+  static void layer_record_feedrate(float mm_s) {
+    long speed = lround(mm_s * LAYER_RECORD_SPEED_SCALE);
+    speed = constrain(speed, 1, 0x7FFF);
+    if (speed == layer_record_speed) return;
+    layer_record_speed = speed;
+    layer_record_t *record = layer_record_next();
+    if (!record) return;
+    record->move.kind = LAYER_REPLAY_FEEDRATE;
+    record->move.y = speed;
+  }
+
+  static int16_t layer_record_steps(float mm, uint8_t axis) {
+    long steps = lround(mm * axis_steps_per_unit[axis]);
+    return constrain(steps, -LAYER_RECORD_MAX_STEPS, LAYER_RECORD_MAX_STEPS);
+  }
+
+  void plan_record_move(float x, float y, float mm_s, bool laser_on) {
+    layer_record_feedrate(mm_s);
+    layer_record_t *record = layer_record_next();
+    if (!record) return;
+    record->move.kind = laser_on ? LAYER_REPLAY_MARK : LAYER_REPLAY_TRAVEL;
+    record->move.x = layer_record_steps(x, X_AXIS);
+    record->move.y = layer_record_steps(y, Y_AXIS);
+  }
+
+  #ifdef LASER_HATCH
+    void plan_record_hatch(float spacing, float angle, float mm_s) {
+      layer_record_feedrate(mm_s);
+      layer_record_hatches = true;
+      for (uint8_t n = 0; n < 3; n++) {
+        layer_record_t *record = layer_record_next();
+        if (!record) return;
+        if (n == 0) record->move.kind = LAYER_REPLAY_HATCH;
+        else record->value = n == 1 ? spacing : angle;
+      }
+    }
+
+    void plan_record_hatch_changed() {
+      if (!layer_record_hatches) return;
+      if (layer_recording) {
+        if (layer_record_status == LAYER_RECORD_OK) layer_record_status = LAYER_RECORD_HATCH;
+      }
+      else
+        layer_record_count = 0;
+    }
+  #endif
+
+  void plan_record_start(float x, float y) {
+    layer_record_count = layer_record_needed = 0;
+    layer_record_status = LAYER_RECORD_OK;
+    layer_record_speed = 0;
+    layer_record_hatches = false;
+    layer_recording = true;
+    // Replays start with a laser-off move to where the layer started
+    plan_record_move(x, y, max_feedrate[X_AXIS], false);
+  }
+
+  uint8_t plan_record_end() {
+    layer_recording = false;
+    if (layer_record_status != LAYER_RECORD_OK) layer_record_count = 0;
+    return layer_record_status;
+  }
+
+  uint8_t plan_recorded_move(uint16_t &i, float values[2], float &mm_s) {
+    const layer_record_t &record = layer_records[i++];
+    uint8_t kind = record.move.kind;
+    switch (kind) {
+      case LAYER_REPLAY_FEEDRATE:
+        mm_s = (float)record.move.y / LAYER_RECORD_SPEED_SCALE;
+        break;
+      case LAYER_REPLAY_HATCH:
+        values[0] = layer_records[i++].value;
+        values[1] = layer_records[i++].value;
+        break;
+      default:
+        values[X_AXIS] = record.move.x / axis_steps_per_unit[X_AXIS];
+        values[Y_AXIS] = record.move.y / axis_steps_per_unit[Y_AXIS];
+    }
+    return kind;
+  }
+
+#endif // LASER_LAYER_REPLAY
+
 // Calculates trapezoid parameters so that the entry- and exit-speed is compensated by the provided factors.
 
 void calculate_trapezoid_for_block(block_t *block, float entry_factor, float exit_factor) {
+  #ifdef PLANNER_DWELL
+    if (block->dwell) return; // Nothing to plan, and the count is kept where the settings would go
+  #endif
+
+  #ifdef GALVO_TIMED_MOTION
+    // Timed blocks keep their settings where the step generator's would be
+    if (block->galvo_timed) {
+      calculate_galvo_trapezoid(block, entry_factor, exit_factor);
+      return;
+    }
+  #endif
+
   unsigned long initial_rate = ceil(block->nominal_rate * entry_factor); // (step/min)
   unsigned long final_rate = ceil(block->nominal_rate * exit_factor); // (step/min)
 
@@ -361,6 +676,9 @@ void plan_init() {
   memset(position, 0, sizeof(position)); // clear position
   for (int i=0; i<NUM_AXIS; i++) previous_speed[i] = 0.0; 
   previous_nominal_speed = 0.0;
+  #ifdef LASER_DELAYS
+    previous_laser_status = LASER_OFF;
+  #endif
 }
 
 
@@ -489,6 +807,11 @@ float junction_deviation = 0.1;
 
   while (block_buffer_tail == next_buffer_head) idle();
 
+  #ifdef LASER_RASTER
+    uint8_t raster_count = raster_pending; // Dropped along with the block if it has no steps
+    raster_pending = 0;
+  #endif
+
   #ifdef MESH_BED_LEVELING
     if (mbl.active) z += mbl.get_z(x, y);
   #elif defined(ENABLE_AUTO_BED_LEVELING)
@@ -566,14 +889,26 @@ float junction_deviation = 0.1;
   block->step_event_count = max(block->steps[X_AXIS], max(block->steps[Y_AXIS], max(block->steps[Z_AXIS], block->steps[E_AXIS])));
 
 #ifdef LASER
-  block->laser_intensity = 255;
   block->laser_status = laser.status;
-  block->x_dac = target[X_AXIS];
-  block->y_dac = target[Y_AXIS];
-  block->x_dac_current = position[X_AXIS];
-  block->y_dac_current = position[Y_AXIS];
-  block->x_dac_step = GRID_SCALAR;
-  block->y_dac_step = GRID_SCALAR;
+  // Hand the stepper the block in final DAC units: start word, end word and the
+  // DAC change per step, so it never has to scale or clamp.
+  block->x_dac_current = galvo_dac_word(position[X_AXIS]);
+  block->y_dac_current = galvo_dac_word(position[Y_AXIS]);
+  block->x_dac = galvo_dac_word(target[X_AXIS]);
+  block->y_dac = galvo_dac_word(target[Y_AXIS]);
+  block->x_dac_step = galvo_dac_step(block->x_dac_current, block->x_dac, block->steps[X_AXIS]);
+  block->y_dac_step = galvo_dac_step(block->y_dac_current, block->y_dac, block->steps[Y_AXIS]);
+  #ifdef GALVO_TIMED_MOTION
+    // Galvo-only moves run on the fixed-rate updater, Z moves keep stepping
+    block->galvo_timed = (block->steps[X_AXIS] || block->steps[Y_AXIS]) && !block->steps[Z_AXIS];
+  #endif
+  #ifdef PLANNER_DWELL
+    block->dwell = false;
+  #endif
+  #ifdef LASER_LAYER_STATS
+    block->layer_start = layer_start_pending;
+    layer_start_pending = false;
+  #endif
 #if LASER_DIAGNOSTICS
   if (block->laser_status == LASER_ON) {
 	  SERIAL_ECHO_START;
@@ -582,8 +917,29 @@ float junction_deviation = 0.1;
 #endif
 #endif // LASER
 
-  // Bail if this is a zero-length block
-  if (block->step_event_count <= dropsegments) return;
+  // Bail if this is a zero-length block. A short raster block is kept down
+  // to one step, as its pixels can't be joined with the next movement.
+  #ifdef LASER_RASTER
+    const unsigned int short_steps = raster_count ? 0 : dropsegments;
+  #else
+    const unsigned int short_steps = dropsegments;
+  #endif
+  if (block->step_event_count <= short_steps) return;
+
+  #ifdef LASER_RASTER
+    // The pixels decide when the laser fires along a raster block
+    block->raster = raster_count && block->galvo_timed;
+    if (block->raster) {
+      block->laser_status = LASER_OFF;
+      block->raster_start = raster_buffer_head;
+      block->raster_pixels = raster_count;
+      raster_buffer_head += raster_count;
+    }
+  #endif
+
+  #if defined(LASER_LAYER_REPLAY) && defined(LASER_RASTER)
+    if (layer_recording && block->raster) layer_record_status = LAYER_RECORD_RASTER; // The pixels aren't kept
+  #endif
 
   block->fan_speed = fanSpeed;
   #ifdef BARICUDA
@@ -714,7 +1070,7 @@ float junction_deviation = 0.1;
   delta_mm[Z_AXIS] = dz / axis_steps_per_unit[Z_AXIS];
   delta_mm[E_AXIS] = (de / axis_steps_per_unit[E_AXIS]) * volumetric_multiplier[extruder] * extruder_multiplier[extruder] / 100.0;
 
-  if (block->steps[X_AXIS] <= dropsegments && block->steps[Y_AXIS] <= dropsegments && block->steps[Z_AXIS] <= dropsegments) {
+  if (block->steps[X_AXIS] <= short_steps && block->steps[Y_AXIS] <= short_steps && block->steps[Z_AXIS] <= short_steps) {
     block->millimeters = fabs(delta_mm[E_AXIS]);
   } 
   else {
@@ -794,6 +1150,16 @@ float junction_deviation = 0.1;
     if (cs > mf) speed_factor = min(speed_factor, mf / cs);
   }
 
+  #ifdef GALVO_KINEMATICS
+    // Keep each mirror within its top angular velocity
+    if (block->galvo_timed) {
+      for (int i = X_AXIS; i <= Y_AXIS; i++) {
+        float cs = fabs(current_speed[i]);
+        if (cs > galvo_max_speed[i]) speed_factor = min(speed_factor, galvo_max_speed[i] / cs);
+      }
+    }
+  #endif
+
   // Max segement time in us.
   #ifdef XY_FREQUENCY_LIMIT
     #define MAX_FREQ_TIME (1000000.0 / XY_FREQUENCY_LIMIT)
@@ -867,6 +1233,21 @@ float junction_deviation = 0.1;
   block->acceleration = acc_st / steps_per_mm;
   block->acceleration_rate = (long)(acc_st * 16777216.0 / (F_CPU / 8.0));
 
+  #ifdef GALVO_KINEMATICS
+    // Galvo-only moves accelerate as hard as the slower mirror can follow
+    if (block->galvo_timed) {
+      float accel = 0;
+      for (int i = X_AXIS; i <= Y_AXIS; i++) {
+        if (!block->steps[i]) continue;
+        float a = galvo_max_acceleration[i] * block->millimeters / fabs(delta_mm[i]);
+        if (!accel || a < accel) accel = a;
+      }
+      block->acceleration = accel;
+      block->acceleration_st = ceil(accel * steps_per_mm);
+      block->acceleration_rate = 0; // Only used by the step generator
+    }
+  #endif
+
   #if 0  // Use old jerk for now
     // Compute path unit vector
     double unit_vec[3];
@@ -934,6 +1315,23 @@ float junction_deviation = 0.1;
 
     vmax_junction = min(previous_nominal_speed, vmax_junction * vmax_junction_factor); // Limit speed to max previous speed
   }
+
+  #ifdef GALVO_KINEMATICS
+    if (block->galvo_timed) {
+      // The mirrors can take a velocity change of up to galvo_max_dv. Through
+      // a corner that's the speed times the change in direction, so straight
+      // runs of short segments keep their speed.
+      safe_speed = min(galvo_max_dv, block->nominal_speed);
+      vmax_junction = safe_speed;
+      if (moves_queued > 1 && previous_nominal_speed > 0.0001) {
+        float ux = current_speed[X_AXIS] / block->nominal_speed - previous_speed[X_AXIS] / previous_nominal_speed,
+              uy = current_speed[Y_AXIS] / block->nominal_speed - previous_speed[Y_AXIS] / previous_nominal_speed,
+              turn = sqrt(ux * ux + uy * uy);
+        vmax_junction = min(block->nominal_speed, previous_nominal_speed);
+        if (vmax_junction * turn > galvo_max_dv) vmax_junction = galvo_max_dv / turn;
+      }
+    }
+  #endif
   block->max_entry_speed = vmax_junction;
 
   // Initialize block entry speed. Compute based on deceleration to user-defined MINIMUM_PLANNER_SPEED.
@@ -951,10 +1349,77 @@ float junction_deviation = 0.1;
   block->nominal_length_flag = (block->nominal_speed <= v_allowable); 
   block->recalculate_flag = true; // Always calculate trapezoid for new block
 
+  #ifdef LASER_DELAYS
+    // The stepper switches the laser at the start of each block, so the
+    // delays are laid out here on the block timeline.
+    block->laser_dwell_ticks = block->laser_on_ticks = 0;
+    if (block->laser_status == LASER_ON) {
+      if (previous_laser_status == LASER_OFF)
+        block->laser_on_ticks = laser_on_delay * (F_CPU / 8000000); // Let the mirrors get going
+      else if (laser_polygon_delay) {
+        // Marking corner: compare the XY directions of this move and the last
+        float cx = current_speed[X_AXIS], cy = current_speed[Y_AXIS],
+              px = previous_speed[X_AXIS], py = previous_speed[Y_AXIS],
+              mag = sqrt((cx * cx + cy * cy) * (px * px + py * py));
+        if (mag > 0 && (cx * px + cy * py) / mag < cos(RADIANS(LASER_POLYGON_ANGLE)))
+          block->laser_dwell_ticks = laser_polygon_delay * (F_CPU / 8000000);
+      }
+    }
+    else if (previous_laser_status == LASER_ON)
+      block->laser_dwell_ticks = laser_off_delay * (F_CPU / 8000000); // Let the mirrors catch up with the mark
+    previous_laser_status = block->laser_status;
+  #endif
+
   // Update previous path unit_vector and nominal speed
   for (int i = 0; i < NUM_AXIS; i++) previous_speed[i] = current_speed[i];
   previous_nominal_speed = block->nominal_speed;
 
+  #if defined(LASER_RASTER) || defined(LASER_PULSED)
+    // Set here, after the step generator fields they share space with
+    bool x_major = block->steps[X_AXIS] >= block->steps[Y_AXIS];
+    long span = x_major ? labs((long)block->x_dac - block->x_dac_current) : labs((long)block->y_dac - block->y_dac_current);
+  #endif
+  #ifdef LASER_RASTER
+    if (block->raster)
+      block->raster_scale = span ? min(((unsigned long)raster_count << 16) / span, 65535UL) : 0;
+  #endif
+  #ifdef LASER_PULSED
+    if (block->galvo_timed && block->laser_status == LASER_ON)
+      block->pulse_scale = span ? min((unsigned long)(laser.ppm * block->millimeters * 65536.0 / span), 65535UL) : 0;
+  #endif
+  #ifdef LASER_VELOCITY_POWER
+    block->laser_intensity = constrain(laser.intensity, 0, 100) * 2.55;
+    if (block->galvo_timed) {
+      // The stepper works out the duty as (speed >> 8) * power_scale >> 16 so
+      // the intensity is reached at the nominal speed. Speed is along the
+      // major axis in DAC steps per update (16.16).
+      block->power_scale = 0;
+      if (laser_velocity_power && block->laser_status == LASER_ON) {
+        long major_steps = max(block->steps[X_AXIS], block->steps[Y_AXIS]);
+        float nominal = block->nominal_speed * major_steps * (65536.0 / 256) * (GRID_SCALAR) / GALVO_UPDATE_RATE / block->millimeters,
+              ceiling = ((unsigned long)block->laser_intensity * (F_CPU / LASER_PWM)) >> 8;
+        if (nominal >= 1) block->power_scale = ceiling * 65536 / nominal;
+      }
+    }
+  #endif
+
+  #ifdef GALVO_JUMP_MODE
+    // Laser-off galvo moves aren't accelerated. The mirrors jump to the end and
+    // settle, so the blocks on either side of a jump start and end at rest.
+    block->galvo_jump = galvo_jump_enabled && block->laser_status == LASER_OFF
+      && (block->steps[X_AXIS] || block->steps[Y_AXIS]) && !block->steps[Z_AXIS];
+    #ifdef LASER_RASTER
+      if (block->raster) block->galvo_jump = false;
+    #endif
+    if (block->galvo_jump) {
+      block->galvo_jump_ticks = galvo_jump_settle_ticks(block->millimeters);
+      block->max_entry_speed = block->entry_speed = 0;
+      block->nominal_length_flag = true;
+      for (int i = 0; i < NUM_AXIS; i++) previous_speed[i] = 0;
+      previous_nominal_speed = 0;
+    }
+  #endif
+
   #ifdef ADVANCE
     // Calculate advance rate
     if (!bse || (!bsx && !bsy && !bsz)) {
@@ -990,6 +1455,68 @@ float junction_deviation = 0.1;
 
 } // plan_buffer_line()
 
+#ifdef PLANNER_DWELL
+
+  /**
+   * Add a pause to the buffer. The stepper sits on the block for ms milliseconds
+   * with the laser off, so a peel can wait on the resin without G4 emptying
+   * the buffer first. The moves on either side stop and start at rest.
+   */
+  void plan_buffer_dwell(unsigned long ms) {
+    if (!ms) return;
+
+    int next_buffer_head = next_block_index(block_buffer_head);
+    while (block_buffer_tail == next_buffer_head) idle();
+
+    block_t *block = &block_buffer[block_buffer_head];
+    block->busy = false;
+
+    for (int i = 0; i < NUM_AXIS; i++) block->steps[i] = 0;
+    block->step_event_count = 0;
+    block->direction_bits = 0;
+    block->active_extruder = active_extruder;
+    block->fan_speed = fanSpeed;
+    block->nominal_speed = block->entry_speed = block->max_entry_speed = 0;
+    block->millimeters = block->acceleration = 0;
+    block->recalculate_flag = false;
+    block->nominal_length_flag = true;
+    block->laser_status = LASER_OFF;
+    block->galvo_timed = false;
+    #ifdef GALVO_JUMP_MODE
+      block->galvo_jump = false;
+    #endif
+    #ifdef LASER_RASTER
+      block->raster = false;
+    #endif
+    block->x_dac = block->x_dac_current = galvo_dac_word(position[X_AXIS]);
+    block->y_dac = block->y_dac_current = galvo_dac_word(position[Y_AXIS]);
+    #ifdef LASER_DELAYS
+      block->laser_dwell_ticks = block->laser_on_ticks = 0;
+      previous_laser_status = LASER_OFF;
+    #endif
+    #ifdef LASER_VELOCITY_POWER
+      block->laser_intensity = 0;
+    #endif
+    block->dwell = true;
+    block->galvo_updates = ms; // 1ms periods
+    #ifdef LASER_LAYER_STATS
+      block->layer_start = layer_start_pending;
+      layer_start_pending = false;
+    #endif
+
+    // The next move starts from rest
+    for (int i = 0; i < NUM_AXIS; i++) previous_speed[i] = 0;
+    previous_nominal_speed = 0;
+
+    block_buffer_head = next_buffer_head;
+
+    planner_recalculate();
+
+    st_wake_up();
+  }
+
+#endif // PLANNER_DWELL
+
 #if defined(ENABLE_AUTO_BED_LEVELING) && !defined(DELTA)
   vector_3 plan_get_position() {
     vector_3 position = vector_3(st_get_position_mm(X_AXIS), st_get_position_mm(Y_AXIS), st_get_position_mm(Z_AXIS));
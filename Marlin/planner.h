@@ -26,6 +26,116 @@
 
 #include "Marlin.h"
 
+#ifdef LASER
+
+/**
+ * Compact block for laser builds.
+ *
+ * SLA vectors are cut into short segments, so the buffer has to hold a lot of
+ * them to give the planner any lookahead. This layout keeps only what the
+ * planner and the galvo interrupt use, in fixed-width fields. A block runs
+ * either on the timed galvo updater or on the step generator (Z moves), so
+ * the two sets of trapezoid fields share their space.
+ */
+typedef struct {
+  int32_t steps[NUM_AXIS];                  // Step count along each axis
+  uint32_t step_event_count;                // The number of step events required to complete this block
+  uint8_t direction_bits;                   // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
+  uint8_t active_extruder;                  // Selects the active extruder
+  uint8_t fan_speed;
+
+  // Fields used by the motion planner to manage acceleration
+  float nominal_speed;                      // The nominal speed for this block in mm/sec
+  float entry_speed;                        // Entry speed at previous-current junction in mm/sec
+  float max_entry_speed;                    // Maximum allowable junction entry speed in mm/sec
+  float millimeters;                        // The total travel of this block in mm
+  float acceleration;                       // acceleration mm/sec^2
+  bool recalculate_flag : 1;                // Planner flag to recalculate trapezoids on entry junction
+  bool nominal_length_flag : 1;             // Planner flag for nominal speed always reached
+  bool laser_status : 1;                    // LASER_OFF, LASER_ON
+  #ifdef GALVO_TIMED_MOTION
+    bool galvo_timed : 1;                   // Executed by the timed galvo updater instead of the step generator
+  #endif
+  #ifdef GALVO_JUMP_MODE
+    bool galvo_jump : 1;                    // Jump straight to the end, then settle
+  #endif
+  #ifdef LASER_RASTER
+    bool raster : 1;                        // The laser follows raster pixels along the block
+  #endif
+  #ifdef PLANNER_DWELL
+    bool dwell : 1;                         // No motion, just wait galvo_updates milliseconds
+  #endif
+  #ifdef LASER_LAYER_STATS
+    bool layer_start : 1;                   // The first block of a layer, after an M663
+  #endif
+
+  uint16_t x_dac;                           // DAC word for the X axis at the end of the block
+  uint16_t y_dac;                           // DAC word for the Y axis at the end of the block
+  uint16_t x_dac_current;                   // DAC word for the X axis at the start of the block
+  uint16_t y_dac_current;                   // DAC word for the Y axis at the start of the block
+  #ifdef LASER_DELAYS
+    uint16_t laser_dwell_ticks;             // Hold the laser as it was for this long before starting (Timer1 ticks)
+    uint16_t laser_on_ticks;                // Turn the laser on this long into the block (Timer1 ticks)
+  #endif
+  #ifdef LASER_VELOCITY_POWER
+    uint8_t laser_intensity;                // Laser power ceiling (0-255)
+  #endif
+  #ifdef LASER_RASTER
+    uint8_t raster_start;                   // First pixel in raster_buffer
+    uint8_t raster_pixels;                  // The number of pixels spread along the block
+  #endif
+
+  union {
+    struct {
+      // Settings for the step generator
+      int32_t accelerate_until;             // The index of the step event on which to stop acceleration
+      int32_t decelerate_after;             // The index of the step event on which to start decelerating
+      int32_t acceleration_rate;            // The acceleration rate used for acceleration calculation
+      uint32_t nominal_rate;                // The nominal step rate for this block in step_events/sec
+      uint32_t initial_rate;                // The jerk-adjusted step rate at start of block
+      uint32_t final_rate;                  // The minimal rate at exit
+      uint32_t acceleration_st;             // acceleration steps/sec^2
+      int32_t x_dac_step;                   // X DAC change per X step (16.16, signed)
+      int32_t y_dac_step;                   // Y DAC change per Y step (16.16, signed)
+    };
+    #ifdef GALVO_TIMED_MOTION
+      struct {
+        // Settings for the timed galvo updater
+        int32_t galvo_rate[2];              // X/Y velocity at block entry in DAC steps per update (16.16, signed)
+        int32_t galvo_accel[2];             // X/Y velocity change per update in DAC steps (16.16, signed)
+        uint32_t galvo_accel_until;         // The update on which to stop accelerating
+        uint32_t galvo_decel_after;         // The update after which to start decelerating
+        uint32_t galvo_updates;             // The number of updates required to complete this block
+        #ifdef GALVO_JUMP_MODE
+          uint16_t galvo_jump_ticks;        // Settle time in Timer1 ticks
+        #endif
+        #ifdef LASER_VELOCITY_POWER
+          uint32_t power_scale;             // PWM duty per unit of major axis speed (speed >> 8, 0.16). 0 for full power.
+        #endif
+        #if defined(LASER_RASTER) || defined(LASER_PULSED)
+          union {
+            #ifdef LASER_RASTER
+              uint16_t raster_scale;        // Pixels per DAC step along the major axis (0.16), raster blocks
+            #endif
+            #ifdef LASER_PULSED
+              uint16_t pulse_scale;         // Pulses per DAC step along the major axis (0.16), marks
+            #endif
+          };
+        #endif
+      };
+    #endif
+  };
+
+  volatile char busy;
+} block_t;
+
+// The laser block buffer gets 3K of RAM
+#ifdef __AVR__
+  static_assert(sizeof(block_t) * BLOCK_BUFFER_SIZE <= 3072, "The laser block buffer is too big. Keep block_t compact or lower BLOCK_BUFFER_SIZE.");
+#endif
+
+#else // !LASER
+
 // This struct is used when buffering the setup for each linear movement "nominal" values are as specified in 
 // the source g-code and may never actually be reached if acceleration management is active.
 typedef struct {
@@ -60,21 +170,6 @@ typedef struct {
   unsigned long final_rate;                          // The minimal rate at exit
   unsigned long acceleration_st;                     // acceleration steps/sec^2
   unsigned long fan_speed;
-#ifdef LASER
-  unsigned long laser_power;
-  bool laser_status; // LASER_OFF, LASER_ON
-  unsigned long laser_ppm; // pulses per millimeter, for pulsed and raster firing modes
-  unsigned long laser_duration; // laser firing duration in microseconds, for pulsed firing mode
-  long steps_l; // step count between firings of the laser, for pulsed firing mode
-  unsigned long laser_intensity; // Laser firing instensity in PWM ticks
-  unsigned short x_dac; // translated dac value for the X axis
-  unsigned short y_dac; // translated dac value for the Y axis
-  unsigned short x_dac_step;
-  unsigned short y_dac_step;
-  unsigned short x_dac_current;
-  unsigned short y_dac_current;
-
-#endif
   #ifdef BARICUDA
     unsigned long valve_pressure;
     unsigned long e_to_p_pressure;
@@ -82,6 +177,8 @@ typedef struct {
   volatile char busy;
 } block_t;
 
+#endif // !LASER
+
 #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
 
 // Initialize the motion plan subsystem      
@@ -148,6 +245,95 @@ extern float max_e_jerk;
 extern float mintravelfeedrate;
 extern unsigned long axis_steps_per_sqr_second[NUM_AXIS];
 
+#ifdef GALVO_JUMP_MODE
+  extern bool galvo_jump_enabled;                           // M656 S
+  extern float galvo_jump_length[GALVO_JUMP_DELAY_POINTS];  // Jump lengths in mm, ascending. M656 P L
+  extern float galvo_jump_delay[GALVO_JUMP_DELAY_POINTS];   // Settle time in us after a jump of that length. M656 P D
+#endif
+
+#ifdef GALVO_KINEMATICS
+  extern float galvo_max_speed[2];        // Top X/Y speed of the mirrors in mm/sec
+  extern float galvo_max_acceleration[2]; // X/Y acceleration the mirrors follow in mm/sec^2
+  extern float galvo_max_dv;              // Velocity change allowed at a corner in mm/sec
+
+  // Work out the galvo limits for a reservoir distance in mm
+  void galvo_kinematics_init(float res_distance);
+#endif
+
+#ifdef LASER_RASTER
+  #define RASTER_BUFFER_SIZE 256 // Pixel ring, so the one byte indexes wrap by themselves
+  extern uint8_t raster_buffer[RASTER_BUFFER_SIZE];
+  extern uint8_t raster_buffer_head;           // Where the next pixels go
+  extern volatile uint8_t raster_buffer_tail;  // The oldest pixel still to be exposed
+
+  // Have the next planned block expose these pixels, evenly spread along it
+  void plan_raster_pixels(const uint8_t *pixels, uint8_t count);
+
+  // The acceleration in mm/sec^2 the planner gives a laser-off line along the
+  // unit vector direction, such as a raster line
+  float plan_raster_acceleration(const float direction[2]);
+#endif
+
+#ifdef LASER_DELAYS
+  extern unsigned int laser_on_delay;      // us from the start of a mark to laser on. M657 O
+  extern unsigned int laser_off_delay;     // us the laser stays on after a mark. M657 F
+  extern unsigned int laser_polygon_delay; // us waited at sharp marking corners. M657 P
+#endif
+
+#ifdef LASER_VELOCITY_POWER
+  extern bool laser_velocity_power;        // Scale laser power with speed. M659 S
+#endif
+
+#ifdef LASER_LAYER_STATS
+  extern bool layer_start_pending;         // The next block planned starts a layer
+#endif
+
+#ifdef PLANNER_DWELL
+  // Queue a pause of ms milliseconds behind the buffered moves
+  void plan_buffer_dwell(unsigned long ms);
+#endif
+
+#ifdef LASER_LAYER_REPLAY
+  extern bool layer_recording;             // Moves are being recorded. M667
+  extern uint16_t layer_record_count;      // Records in the recorded layer, 0 if there's none to replay
+  extern uint16_t layer_record_needed;     // Records asked for since M667, kept or not (stops at 0xFFFF)
+
+  // What plan_record_end() found
+  #define LAYER_RECORD_OK 0
+  #define LAYER_RECORD_FULL 1              // More than LAYER_REPLAY_MOVES records
+  #define LAYER_RECORD_RASTER 2            // Raster lines, whose pixels aren't kept
+  #define LAYER_RECORD_HATCH 3             // The hatch polygon changed after the layer filled it
+
+  // Kinds of recorded move
+  #define LAYER_REPLAY_TRAVEL 0            // Laser-off move
+  #define LAYER_REPLAY_MARK 1              // Marking move
+  #define LAYER_REPLAY_FEEDRATE 2          // Feedrate of the moves after it
+  #define LAYER_REPLAY_HATCH 3             // Hatch fill of the hatch polygon (M662)
+
+  // Start recording moves, from cartesian x, y
+  void plan_record_start(float x, float y);
+
+  // Keep a move to cartesian x, y as asked for, before it's cut into galvo segments
+  void plan_record_move(float x, float y, float mm_s, bool laser_on);
+
+  #ifdef LASER_HATCH
+    // Keep a hatch fill in place of the moves it makes
+    void plan_record_hatch(float spacing, float angle, float mm_s);
+
+    // The hatch polygon changed (M660, M661). A layer that fills the old one
+    // can't be replayed.
+    void plan_record_hatch_changed();
+  #endif
+
+  // Stop recording. The layer is kept only if this returns LAYER_RECORD_OK.
+  uint8_t plan_record_end();
+
+  // Recorded move i, moving i past it: returns its kind and sets the feedrate
+  // for LAYER_REPLAY_FEEDRATE, the spacing and angle for LAYER_REPLAY_HATCH,
+  // or the cartesian target for the others.
+  uint8_t plan_recorded_move(uint16_t &i, float values[2], float &mm_s);
+#endif
+
 #ifdef AUTOTEMP
   extern bool autotemp_enabled;
   extern float autotemp_max;
@@ -31,6 +31,7 @@
 #ifdef LASER
   #include <SPI.h>
 #include "laser.h"
+#include "galvo_dac.h"
 #include "avr/pgmspace.h"
 #else
 #include "temperature.h"
@@ -81,6 +82,53 @@ static unsigned short step_loops_nominal;
 volatile unsigned long X_Galvo_Position;
 volatile unsigned long Y_Galvo_Position;
 
+#ifdef LASER
+  static unsigned long galvo_dac[2];        // Current X/Y DAC position (16.16)
+#endif
+
+#ifdef GALVO_JUMP_MODE
+  static bool galvo_settling;               // The current jump block has jumped and is settling
+#endif
+
+#if defined(LASER_RASTER) || defined(LASER_PULSED) || defined(LASER_VELOCITY_POWER)
+  static uint8_t travel_axis;               // The axis raster pixels, laser pulses and speed are measured along
+  static unsigned long travel_origin;       // DAC position on that axis at the start of the block (16.16)
+#endif
+
+#ifdef LASER_LAYER_STATS
+  static layer_stats_t layer_stats;         // Updated by the stepper interrupt only
+  static bool layer_started;                // A block of this layer has run
+  static layer_stats_t last_layer_stats;    // The last layer finished
+  static int layer_number = 0, last_layer_number = -1;
+  #define LAYER_MARKERS 4                   // Layer starts queued ahead of the stepper, a power of 2
+  static int layer_marker_numbers[LAYER_MARKERS];
+  static volatile uint8_t layer_markers_head, layer_markers_tail;
+#endif
+
+#ifdef LASER_VELOCITY_POWER
+  static unsigned int laser_power_ceiling;  // PWM duty for the block's intensity, 0 for laser-off blocks
+#endif
+
+#ifdef LASER_PULSED
+  static volatile bool laser_pulse_on;      // A pulse is being fired
+  static long laser_pulse_ticks;            // Ticks from the start of this timer period to the end of the pulse
+  static unsigned long laser_pulse_phase;   // Part of a pulse spacing travelled before this block (0.16)
+  static unsigned long laser_pulses;        // Pulses fired in this block
+#endif
+
+#ifdef LASER_DELAYS
+  static bool laser_dwelling;               // Holding the laser at the start of the current block
+  static volatile bool laser_on_pending;    // The laser turns on partway into the block
+  static long laser_on_ticks;               // Ticks from the start of this timer period to the laser turning on
+#endif
+
+#ifdef GALVO_TIMED_MOTION
+  // Variables used by the timed galvo updater
+  static unsigned long galvo_update_count;  // The number of updates executed in the current block
+  static long galvo_velocity[2];            // Current X/Y velocity in DAC steps per update (16.16)
+  static unsigned long galvo_dac_end[2];    // X/Y DAC position at the end of the current block (16.16)
+#endif
+
 volatile long endstops_trigsteps[3] = { 0 };
 volatile long endstops_stepsTotal, endstops_stepsDone;
 static volatile char endstop_hit_bits = 0; // use X_MIN, Y_MIN, Z_MIN and Z_PROBE as BIT value
@@ -106,16 +154,7 @@ volatile long count_position[NUM_AXIS] = { 0 };
 volatile signed char count_direction[NUM_AXIS] = { 1, 1, 1, 1 };
 
 #ifdef LASER
-/*
-  This table contains a mapping from 0 to 2048 for a tangent translated DAC value.
-  This corrects for curvature as a result of projection. Note that this table will
-  need to be recreated should the distance of laser to resevoir change
-*/
-const uint16_t PROGMEM dac_table[] = { 0, 17, 35, 52, 70, 87, 104, 122, 139, 157, 174, 192, 209, 226, 244, 261, 279, 296, 313, 331, 348, 366, 383, 401, 418, 435, 453, 470, 488, 505, 522, 540, 557, 575, 592, 610, 627, 644, 662, 679, 697, 714, 731, 749, 766, 784, 801, 819, 836, 853, 871, 888, 906, 923, 940, 958, 975, 993, 1010, 1027, 1045, 1062, 1080, 1097, 1115, 1132, 1149, 1167, 1184, 1202, 1219, 1236, 1254, 1271, 1289, 1306, 1323, 1341, 1358, 1376, 1393, 1410, 1428, 1445, 1463, 1480, 1498, 1515, 1532, 1550, 1567, 1585, 1602, 1619, 1637, 1654, 1672, 1689, 1706, 1724, 1741, 1759, 1776, 1793, 1811, 1828, 1846, 1863, 1880, 1898, 1915, 1933, 1950, 1967, 1985, 2002, 2020, 2037, 2054, 2072, 2089, 2107, 2124, 2141, 2159, 2176, 2194, 2211, 2228, 2246, 2263, 2281, 2298, 2315, 2333, 2350, 2368, 2385, 2402, 2420, 2437, 2455, 2472, 2489, 2507, 2524, 2542, 2559, 2576, 2594, 2611, 2628, 2646, 2663, 2681, 2698, 2715, 2733, 2750, 2768, 2785, 2802, 2820, 2837, 2854, 2872, 2889, 2907, 2924, 2941, 2959, 2976, 2994, 3011, 3028, 3046, 3063, 3080, 3098, 3115, 3133, 3150, 3167, 3185, 3202, 3219, 3237, 3254, 3272, 3289, 3306, 3324, 3341, 3358, 3376, 3393, 3411, 3428, 3445, 3463, 3480, 3497, 3515, 3532, 3550, 3567, 3584, 3602, 3619, 3636, 3654, 3671, 3688, 3706, 3723, 3741, 3758, 3775, 3793, 3810, 3827, 3845, 3862, 3879, 3897, 3914, 3931, 3949, 3966, 3984, 4001, 4018, 4036, 4053, 4070, 4088, 4105, 4122, 4140, 4157, 4174, 4192, 4209, 4226, 4244, 4261, 4278, 4296, 4313, 4331, 4348, 4365, 4383, 4400, 4417, 4435, 4452, 4469, 4487, 4504, 4521, 4539, 4556, 4573, 4591, 4608, 4625, 4643, 4660, 4677, 4695, 4712, 4729, 4747, 4764, 4781, 4799, 4816, 4833, 4851, 4868, 4885, 4902, 4920, 4937, 4954, 4972, 4989, 5006, 5024, 5041, 5058, 5076, 5093, 5110, 5128, 5145, 5162, 5180, 5197, 5214, 5232, 5249, 5266, 5283, 5301, 5318, 5335, 5353, 5370, 5387, 5405, 5422, 5439, 5456, 5474, 5491, 5508, 5526, 5543, 5560, 5578, 5595, 5612, 5629, 5647, 5664, 5681, 5699, 5716, 5733, 5750, 5768, 5785, 5802, 5820, 5837, 5854, 5871, 5889, 5906, 5923, 5941, 5958, 5975, 5992, 6010, 6027, 6044, 6062, 6079, 6096, 6113, 6131, 6148, 6165, 6182, 6200, 6217, 6234, 6251, 6269, 6286, 6303, 6321, 6338, 6355, 6372, 6390, 6407, 6424, 6441, 6459, 6476, 6493, 6510, 6528, 6545, 6562, 6579, 6597, 6614, 6631, 6648, 6666, 6683, 6700, 6717, 6735, 6752, 6769, 6786, 6803, 6821, 6838, 6855, 6872, 6890, 6907, 6924, 6941, 6959, 6976, 6993, 7010, 7027, 7045, 7062, 7079, 7096, 7114, 7131, 7148, 7165, 7182, 7200, 7217, 7234, 7251, 7269, 7286, 7303, 7320, 7337, 7355, 7372, 7389, 7406, 7423, 7441, 7458, 7475, 7492, 7509, 7527, 7544, 7561, 7578, 7595, 7613, 7630, 7647, 7664, 7681, 7698, 7716, 7733, 7750, 7767, 7784, 7802, 7819, 7836, 7853, 7870, 7887, 7905, 7922, 7939, 7956, 7973, 7991, 8008, 8025, 8042, 8059, 8076, 8094, 8111, 8128, 8145, 8162, 8179, 8196, 8214, 8231, 8248, 8265, 8282, 8299, 8317, 8334, 8351, 8368, 8385, 8402, 8419, 8437, 8454, 8471, 8488, 8505, 8522, 8539, 8556, 8574, 8591, 8608, 8625, 8642, 8659, 8676, 8694, 8711, 8728, 8745, 8762, 8779, 8796, 8813, 8830, 8848, 8865, 8882, 8899, 8916, 8933, 8950, 8967, 8984, 9002, 9019, 9036, 9053, 9070, 9087, 9104, 9121, 9138, 9155, 9173, 9190, 9207, 9224, 9241, 9258, 9275, 9292, 9309, 9326, 9343, 9360, 9377, 9395, 9412, 9429, 9446, 9463, 9480, 9497, 9514, 9531, 9548, 9565, 9582, 9599, 9616, 9633, 9651, 9668, 9685, 9702, 9719, 9736, 9753, 9770, 9787, 9804, 9821, 9838, 9855, 9872, 9889, 9906, 9923, 9940, 9957, 9974, 9991, 10008, 10025, 10042, 10060, 10077, 10094, 10111, 10128, 10145, 10162, 10179, 10196, 10213, 10230, 10247, 10264, 10281, 10298, 10315, 10332, 10349, 10366, 10383, 10400, 10417, 10434, 10451, 10468, 10485, 10502, 10519, 10536, 10553, 10570, 10587, 10604, 10621, 10638, 10655, 10672, 10689, 10706, 10722, 10739, 10756, 10773, 10790, 10807, 10824, 10841, 10858, 10875, 10892, 10909, 10926, 10943, 10960, 10977, 10994, 11011, 11028, 11045, 11062, 11079, 11096, 11112, 11129, 11146, 11163, 11180, 11197, 11214, 11231, 11248, 11265, 11282, 11299, 11316, 11333, 11349, 11366, 11383, 11400, 11417, 11434, 11451, 11468, 11485, 11502, 11519, 11535, 11552, 11569, 11586, 11603, 11620, 11637, 11654, 11671, 11688, 11704, 11721, 11738, 11755, 11772, 11789, 11806, 11823, 11840, 11856, 11873, 11890, 11907, 11924, 11941, 11958, 11974, 11991, 12008, 12025, 12042, 12059, 12076, 12092, 12109, 12126, 12143, 12160, 12177, 12194, 12210, 12227, 12244, 12261, 12278, 12295, 12311, 12328, 12345, 12362, 12379, 12396, 12412, 12429, 12446, 12463, 12480, 12496, 12513, 12530, 12547, 12564, 12581, 12597, 12614, 12631, 12648, 12665, 12681, 12698, 12715, 12732, 12749, 12765, 12782, 12799, 12816, 12832, 12849, 12866, 12883, 12900, 12916, 12933, 12950, 12967, 12983, 13000, 13017, 13034, 13050, 13067, 13084, 13101, 13118, 13134, 13151, 13168, 13185, 13201, 13218, 13235, 13252, 13268, 13285, 13302, 13318, 13335, 13352, 13369, 13385, 13402, 13419, 13436, 13452, 13469, 13486, 13502, 13519, 13536, 13553, 13569, 13586, 13603, 13619, 13636, 13653, 13669, 13686, 13703, 13720, 13736, 13753, 13770, 13786, 13803, 13820, 13836, 13853, 13870, 13886, 13903, 13920, 13936, 13953, 13970, 13986, 14003, 14020, 14036, 14053, 14070, 14086, 14103, 14120, 14136, 14153, 14170, 14186, 14203, 14220, 14236, 14253, 14270, 14286, 14303, 14319, 14336, 14353, 14369, 14386, 14403, 14419, 14436, 14452, 14469, 14486, 14502, 14519, 14535, 14552, 14569, 14585, 14602, 14618, 14635, 14652, 14668, 14685, 14701, 14718, 14735, 14751, 14768, 14784, 14801, 14817, 14834, 14851, 14867, 14884, 14900, 14917, 14933, 14950, 14967, 14983, 15000, 15016, 15033, 15049, 15066, 15082, 15099, 15116, 15132, 15149, 15165, 15182, 15198, 15215, 15231, 15248, 15264, 15281, 15297, 15314, 15330, 15347, 15363, 15380, 15396, 15413, 15429, 15446, 15462, 15479, 15495, 15512, 15528, 15545, 15561, 15578, 15594, 15611, 15627, 15644, 15660, 15677, 15693, 15710, 15726, 15743, 15759, 15776, 15792, 15809, 15825, 15841, 15858, 15874, 15891, 15907, 15924, 15940, 15957, 15973, 15990, 16006, 16022, 16039, 16055, 16072, 16088, 16105, 16121, 16137, 16154, 16170, 16187, 16203, 16219, 16236, 16252, 16269, 16285, 16302, 16318, 16334, 16351, 16367, 16384, 16400, 16416, 16433, 16449, 16465, 16482, 16498, 16515, 16531, 16547, 16564, 16580, 16596, 16613, 16629, 16646, 16662, 16678, 16695, 16711, 16727, 16744, 16760, 16776, 16793, 16809, 16825, 16842, 16858, 16874, 16891, 16907, 16923, 16940, 16956, 16972, 16989, 17005, 17021, 17038, 17054, 17070, 17086, 17103, 17119, 17135, 17152, 17168, 17184, 17201, 17217, 17233, 17249, 17266, 17282, 17298, 17315, 17331, 17347, 17363, 17380, 17396, 17412, 17428, 17445, 17461, 17477, 17493, 17510, 17526, 17542, 17558, 17575, 17591, 17607, 17623, 17640, 17656, 17672, 17688, 17704, 17721, 17737, 17753, 17769, 17786, 17802, 17818, 17834, 17850, 17867, 17883, 17899, 17915, 17931, 17948, 17964, 17980, 17996, 18012, 18029, 18045, 18061, 18077, 18093, 18109, 18126, 18142, 18158, 18174, 18190, 18206, 18223, 18239, 18255, 18271, 18287, 18303, 18319, 18336, 18352, 18368, 18384, 18400, 18416, 18432, 18448, 18465, 18481, 18497, 18513, 18529, 18545, 18561, 18577, 18594, 18610, 18626, 18642, 18658, 18674, 18690, 18706, 18722, 18738, 18754, 18771, 18787, 18803, 18819, 18835, 18851, 18867, 18883, 18899, 18915, 18931, 18947, 18963, 18979, 18995, 19011, 19028, 19044, 19060, 19076, 19092, 19108, 19124, 19140, 19156, 19172, 19188, 19204, 19220, 19236, 19252, 19268, 19284, 19300, 19316, 19332, 19348, 19364, 19380, 19396, 19412, 19428, 19444, 19460, 19476, 19492, 19508, 19524, 19540, 19556, 19572, 19588, 19604, 19620, 19636, 19651, 19667, 19683, 19699, 19715, 19731, 19747, 19763, 19779, 19795, 19811, 19827, 19843, 19859, 19875, 19891, 19906, 19922, 19938, 19954, 19970, 19986, 20002, 20018, 20034, 20050, 20066, 20081, 20097, 20113, 20129, 20145, 20161, 20177, 20193, 20208, 20224, 20240, 20256, 20272, 20288, 20304, 20320, 20335, 20351, 20367, 20383, 20399, 20415, 20430, 20446, 20462, 20478, 20494, 20510, 20525, 20541, 20557, 20573, 20589, 20605, 20620, 20636, 20652, 20668, 20684, 20699, 20715, 20731, 20747, 20763, 20778, 20794, 20810, 20826, 20842, 20857, 20873, 20889, 20905, 20920, 20936, 20952, 20968, 20983, 20999, 21015, 21031, 21046, 21062, 21078, 21094, 21109, 21125, 21141, 21157, 21172, 21188, 21204, 21220, 21235, 21251, 21267, 21282, 21298, 21314, 21330, 21345, 21361, 21377, 21392, 21408, 21424, 21439, 21455, 21471, 21486, 21502, 21518, 21533, 21549, 21565, 21580, 21596, 21612, 21627, 21643, 21659, 21674, 21690, 21706, 21721, 21737, 21753, 21768, 21784, 21800, 21815, 21831, 21846, 21862, 21878, 21893, 21909, 21924, 21940, 21956, 21971, 21987, 22003, 22018, 22034, 22049, 22065, 22080, 22096, 22112, 22127, 22143, 22158, 22174, 22190, 22205, 22221, 22236, 22252, 22267, 22283, 22298, 22314, 22330, 22345, 22361, 22376, 22392, 22407, 22423, 22438, 22454, 22469, 22485, 22500, 22516, 22531, 22547, 22562, 22578, 22593, 22609, 22624, 22640, 22655, 22671, 22686, 22702, 22717, 22733, 22748, 22764, 22779, 22795, 22810, 22826, 22841, 22857, 22872, 22888, 22903, 22918, 22934, 22949, 22965, 22980, 22996, 23011, 23027, 23042, 23057, 23073, 23088, 23104, 23119, 23134, 23150, 23165, 23181, 23196, 23212, 23227, 23242, 23258, 23273, 23288, 23304, 23319, 23335, 23350, 23365, 23381, 23396, 23412, 23427, 23442, 23458, 23473, 23488, 23504, 23519, 23534, 23550, 23565, 23580, 23596, 23611, 23626, 23642, 23657, 23672, 23688, 23703, 23718, 23734, 23749, 23764, 23780, 23795, 23810, 23825, 23841, 23856, 23871, 23887, 23902, 23917, 23933, 23948, 23963, 23978, 23994, 24009, 24024, 24039, 24055, 24070, 24085, 24100, 24116, 24131, 24146, 24161, 24177, 24192, 24207, 24222, 24238, 24253, 24268, 24283, 24298, 24314, 24329, 24344, 24359, 24374, 24390, 24405, 24420, 24435, 24450, 24466, 24481, 24496, 24511, 24526, 24542, 24557, 24572, 24587, 24602, 24617, 24633, 24648, 24663, 24678, 24693, 24708, 24723, 24739, 24754, 24769, 24784, 24799, 24814, 24829, 24845, 24860, 24875, 24890, 24905, 24920, 24935, 24950, 24965, 24981, 24996, 25011, 25026, 25041, 25056, 25071, 25086, 25101, 25116, 25131, 25146, 25161, 25177, 25192, 25207, 25222, 25237, 25252, 25267, 25282, 25297, 25312, 25327, 25342, 25357, 25372, 25387, 25402, 25417, 25432, 25447, 25462, 25477, 25492, 25507, 25522, 25537, 25552, 25567, 25582, 25597, 25612, 25627, 25642, 25657, 25672, 25687, 25702, 25717, 25732, 25747, 25762, 25777, 25792, 25807, 25822, 25837, 25852, 25867, 25881, 25896, 25911, 25926, 25941, 25956, 25971, 25986, 26001, 26016, 26031, 26046, 26061, 26075, 26090, 26105, 26120, 26135, 26150, 26165, 26180, 26195, 26209, 26224, 26239, 26254, 26269, 26284, 26299, 26313, 26328, 26343, 26358, 26373, 26388, 26403, 26417, 26432, 26447, 26462, 26477, 26492, 26506, 26521, 26536, 26551, 26566, 26580, 26595, 26610, 26625, 26640, 26654, 26669, 26684, 26699, 26714, 26728, 26743, 26758, 26773, 26787, 26802, 26817, 26832, 26846, 26861, 26876, 26891, 26906, 26920, 26935, 26950, 26964, 26979, 26994, 27009, 27023, 27038, 27053, 27068, 27082, 27097, 27112, 27126, 27141, 27156, 27170, 27185, 27200, 27215, 27229, 27244, 27259, 27273, 27288, 27303, 27317, 27332, 27347, 27361, 27376, 27391, 27405, 27420, 27435, 27449, 27464, 27478, 27493, 27508, 27522, 27537, 27552, 27566, 27581, 27595, 27610, 27625, 27639, 27654, 27669, 27683, 27698, 27712, 27727, 27742, 27756, 27771, 27785, 27800, 27814, 27829, 27844, 27858, 27873, 27887, 27902, 27916, 27931, 27945, 27960, 27975, 27989, 28004, 28018, 28033, 28047, 28062, 28076, 28091, 28105, 28120, 28134, 28149, 28163, 28178, 28192, 28207, 28221, 28236, 28250, 28265, 28279, 28294, 28308, 28323, 28337, 28352, 28366, 28381, 28395, 28410, 28424, 28438, 28453, 28467, 28482, 28496, 28511, 28525, 28540, 28554, 28568, 28583, 28597, 28612, 28626, 28641, 28655, 28669, 28684, 28698, 28713, 28727, 28741, 28756, 28770, 28784, 28799, 28813, 28828, 28842, 28856, 28871, 28885, 28899, 28914, 28928, 28943, 28957, 28971, 28986, 29000, 29014, 29029, 29043, 29057, 29072, 29086, 29100, 29115, 29129, 29143, 29158, 29172, 29186, 29200, 29215, 29229, 29243, 29258, 29272, 29286, 29300, 29315, 29329, 29343, 29358, 29372, 29386, 29400, 29415, 29429, 29443, 29457, 29472, 29486, 29500, 29514, 29529, 29543, 29557, 29571, 29586, 29600, 29614, 29628, 29642, 29657, 29671, 29685, 29699, 29713, 29728, 29742, 29756, 29770, 29784, 29799, 29813, 29827, 29841, 29855, 29869, 29884, 29898, 29912, 29926, 29940, 29954, 29969, 29983, 29997, 30011, 30025, 30039, 30053, 30067, 30082, 30096, 30110, 30124, 30138, 30152, 30166, 30180, 30195, 30209, 30223, 30237, 30251, 30265, 30279, 30293, 30307, 30321, 30335, 30349, 30364, 30378, 30392, 30406, 30420, 30434, 30448, 30462, 30476, 30490, 30504, 30518, 30532, 30546, 30560, 30574, 30588, 30602, 30616, 30630, 30644, 30658, 30672, 30686, 30700, 30714, 30728, 30742, 30756, 30770, 30784, 30798, 30812, 30826, 30840, 30854, 30868, 30882, 30896, 30910, 30924, 30938, 30952, 30966, 30980, 30994, 31007, 31021, 31035, 31049, 31063, 31077, 31091, 31105, 31119, 31133, 31147, 31161, 31174, 31188, 31202, 31216, 31230, 31244, 31258, 31272, 31286, 31299, 31313, 31327, 31341, 31355, 31369, 31383, 31396, 31410, 31424, 31438, 31452, 31466, 31480, 31493, 31507, 31521, 31535, 31549, 31562, 31576, 31590, 31604, 31618, 31632, 31645, 31659, 31673, 31687, 31700, 31714, 31728, 31742, 31756, 31769, 31783, 31797, 31811, 31824, 31838, 31852, 31866, 31879, 31893, 31907, 31921, 31934, 31948, 31962, 31976, 31989, 32003, 32017, 32031, 32044, 32058, 32072, 32085, 32099, 32113, 32126, 32140, 32154, 32168, 32181, 32195, 32209, 32222, 32236, 32250, 32263, 32277, 32291, 32304, 32318, 32332, 32345, 32359, 32373, 32386, 32400, 32413, 32427, 32441, 32454, 32468, 32482, 32495, 32509, 32522, 32536, 32550, 32563, 32577, 32590, 32604, 32618, 32631, 32645, 32658, 32672, 32686, 32699, 32713, 32726, 32740, 32753, 32767 };
-const int grid = GRID_SIZE >> 1;
-volatile int offset_value;
 volatile int scaled_value;
-volatile int sign;
 #endif
 
 //===========================================================================
@@ -263,6 +302,10 @@ volatile int sign;
 
 #define ENABLE_STEPPER_DRIVER_INTERRUPT()  TIMSK1 |= BIT(OCIE1A)
 #define DISABLE_STEPPER_DRIVER_INTERRUPT() TIMSK1 &= ~BIT(OCIE1A)
+#define ENABLE_LASER_EVENT_INTERRUPT()     TIMSK1 |= BIT(OCIE1B)
+#define DISABLE_LASER_EVENT_INTERRUPT()    TIMSK1 &= ~BIT(OCIE1B)
+#define ENABLE_LASER_PULSE_INTERRUPT()     TIMSK1 |= BIT(OCIE1C)
+#define DISABLE_LASER_PULSE_INTERRUPT()    TIMSK1 &= ~BIT(OCIE1C)
 
 void endstops_hit_on_purpose() {
   endstop_hit_bits = 0;
@@ -421,6 +464,373 @@ void set_stepper_direction() {
   #endif //!ADVANCE
 }
 
+#ifdef LASER
+
+  // Write the galvos that moved this tick. When both moved they're
+  // written as a pair so GALVO_DAC_LATCH can move them together.
+  FORCE_INLINE void galvo_output(bool x_moved, bool y_moved, unsigned short x, unsigned short y) {
+    if (x_moved && y_moved) galvo_dac_move_xy(x, y);
+    else if (x_moved) galvo_dac_move(X_AXIS, x);
+    else if (y_moved) galvo_dac_move(Y_AXIS, y);
+  }
+
+  // Keep the galvo grid position in step with the finished block
+  FORCE_INLINE void galvo_block_done() {
+    X_Galvo_Position += count_direction[X_AXIS] * current_block->steps[X_AXIS];
+    Y_Galvo_Position += count_direction[Y_AXIS] * current_block->steps[Y_AXIS];
+  }
+
+  // Bring the step counters in line with a block the galvos did in one go
+  FORCE_INLINE void galvo_block_counted() {
+    count_position[X_AXIS] += count_direction[X_AXIS] * current_block->steps[X_AXIS];
+    count_position[Y_AXIS] += count_direction[Y_AXIS] * current_block->steps[Y_AXIS];
+    galvo_block_done();
+  }
+
+  #if LASER_CONTROL == 1
+    FORCE_INLINE void laser_output(bool on) {
+      #ifdef INVERT_LASER
+        WRITE(LASER_FIRING_PIN, !on);
+      #else
+        WRITE(LASER_FIRING_PIN, on);
+      #endif
+      laser.firing = on;
+    }
+  #endif
+
+#endif // LASER
+
+#if defined(LASER_RASTER) || defined(LASER_PULSED)
+
+  // DAC steps the galvos have gone along the block's major axis
+  FORCE_INLINE unsigned long galvo_travel() {
+    unsigned long dac = galvo_dac[travel_axis];
+    return (dac > travel_origin ? dac - travel_origin : travel_origin - dac) >> 16;
+  }
+
+#endif
+
+#ifdef LASER_RASTER
+
+  // Expose one pixel: PWM duty with LASER_CONTROL 3, on or off otherwise
+  FORCE_INLINE void raster_output(uint8_t pixel) {
+    #if LASER_CONTROL == 3
+      OCR4A = ((unsigned long)pixel * (F_CPU / LASER_PWM)) >> 8;
+    #else
+      laser_output(pixel >= LASER_RASTER_THRESHOLD);
+    #endif
+  }
+
+  // Set the laser for the pixel the galvos are over. Pixels are found by how
+  // far the major axis has gone, so exposure stays put if the speed varies.
+  FORCE_INLINE void raster_update() {
+    unsigned long pixel = (galvo_travel() * current_block->raster_scale) >> 16;
+    if (pixel >= current_block->raster_pixels) pixel = current_block->raster_pixels - 1;
+    raster_output(raster_buffer[(uint8_t)(current_block->raster_start + pixel)]);
+  }
+
+  // Leave the laser off and hand the block's pixels back to the planner
+  FORCE_INLINE void raster_done() {
+    raster_output(0);
+    raster_buffer_tail = current_block->raster_start + current_block->raster_pixels;
+  }
+
+#endif // LASER_RASTER
+
+#if defined(LASER_DELAYS) || defined(LASER_PULSED)
+  // Events closer than this to the end of a timer period are done right away
+  #define LASER_EVENT_MIN_TICKS 20
+#endif
+
+#ifdef LASER_DELAYS
+
+  FORCE_INLINE void laser_on_fire() {
+    DISABLE_LASER_EVENT_INTERRUPT();
+    laser_on_pending = false;
+    laser_output(LASER_ON);
+  }
+
+  FORCE_INLINE void laser_on_cancel() {
+    DISABLE_LASER_EVENT_INTERRUPT();
+    laser_on_pending = false;
+  }
+
+  // Point Compare B at the laser-on, if it's due within this timer period
+  FORCE_INLINE void laser_on_arm() {
+    if (laser_on_ticks <= 0xFFFF) {
+      OCR1B = laser_on_ticks;
+      TIFR1 = BIT(OCF1B); // Drop any stale match
+      ENABLE_LASER_EVENT_INTERRUPT();
+    }
+    else
+      DISABLE_LASER_EVENT_INTERRUPT();
+  }
+
+  // Count a pending laser-on down by the timer period that just ended.
+  // Compare B never matches past OCR1A, so a late event fires here instead.
+  FORCE_INLINE void laser_on_period(unsigned short period) {
+    if (!laser_on_pending) return;
+    laser_on_ticks -= period;
+    if (laser_on_ticks < LASER_EVENT_MIN_TICKS)
+      laser_on_fire();
+    else
+      laser_on_arm();
+  }
+
+  // Switch the laser to the state of the block that's starting
+  FORCE_INLINE void laser_block_start() {
+    if (current_block->laser_status == LASER_ON) {
+      if (laser.firing || laser_on_pending) return;
+      if (current_block->laser_on_ticks < LASER_EVENT_MIN_TICKS)
+        laser_output(LASER_ON);
+      else {
+        laser_on_ticks = current_block->laser_on_ticks;
+        laser_on_pending = true;
+        laser_on_arm();
+      }
+    }
+    else {
+      laser_on_cancel();
+      if (laser.firing) laser_output(LASER_OFF);
+    }
+  }
+
+  // The delayed laser-on of the current block
+  ISR(TIMER1_COMPB_vect) {
+    if (laser_on_pending) laser_on_fire();
+  }
+
+#endif // LASER_DELAYS
+
+#ifdef LASER_PULSED
+
+  FORCE_INLINE void laser_pulse_end() {
+    DISABLE_LASER_PULSE_INTERRUPT();
+    laser_pulse_on = false;
+    laser_output(LASER_OFF);
+  }
+
+  // Point Compare C at the end of the pulse, if it's due within this timer period
+  FORCE_INLINE void laser_pulse_arm() {
+    if (laser_pulse_ticks <= 0xFFFF) {
+      OCR1C = laser_pulse_ticks;
+      TIFR1 = BIT(OCF1C); // Drop any stale match
+      ENABLE_LASER_PULSE_INTERRUPT();
+    }
+    else
+      DISABLE_LASER_PULSE_INTERRUPT();
+  }
+
+  // Count the pulse down by the timer period that just ended, as for the laser-on delay
+  FORCE_INLINE void laser_pulse_period(unsigned short period) {
+    if (!laser_pulse_on) return;
+    laser_pulse_ticks -= period;
+    if (laser_pulse_ticks < LASER_EVENT_MIN_TICKS)
+      laser_pulse_end();
+    else
+      laser_pulse_arm();
+  }
+
+  // Start a pulse. A pulse still going is stretched.
+  FORCE_INLINE void laser_pulse_fire() {
+    laser_output(LASER_ON);
+    laser_pulse_on = true;
+    laser_pulse_ticks = TCNT1 + laser.pulse_ticks;
+    laser_pulse_arm();
+  }
+
+  // Fire a pulse each time the galvos go another 1/ppm along a mark. Going by
+  // travel rather than time keeps the spacing through acceleration.
+  FORCE_INLINE void laser_pulse_update(bool done) {
+    unsigned long due = laser_pulse_phase + galvo_travel() * current_block->pulse_scale;
+    if ((due >> 16) > laser_pulses) {
+      laser_pulses = due >> 16;
+      laser_pulse_fire();
+    }
+    // Carry the spacing on into the next block
+    if (done) laser_pulse_phase = due - (laser_pulses << 16);
+  }
+
+  // The end of the pulse
+  ISR(TIMER1_COMPC_vect) {
+    if (laser_pulse_on) laser_pulse_end();
+  }
+
+#endif // LASER_PULSED
+
+#ifdef LASER_VELOCITY_POWER
+
+  // Set the laser to the block's intensity, or off
+  FORCE_INLINE void laser_power_start() {
+    laser_power_ceiling = current_block->laser_status == LASER_ON
+      ? ((unsigned long)current_block->laser_intensity * (F_CPU / LASER_PWM)) >> 8 : 0;
+    OCR4A = laser_power_ceiling;
+  }
+
+  // Scale the power with the galvo speed, so the ramps at the ends of a mark
+  // get no more energy per mm than the middle. No more than the intensity.
+  FORCE_INLINE void laser_power_update() {
+    if (!laser_power_ceiling || !current_block->power_scale) return;
+    long v = galvo_velocity[travel_axis];
+    unsigned long duty = (((unsigned long)(v < 0 ? -v : v) >> 8) * current_block->power_scale) >> 16;
+    OCR4A = duty < laser_power_ceiling ? duty : laser_power_ceiling;
+  }
+
+#endif // LASER_VELOCITY_POWER
+
+#ifdef LASER_LAYER_STATS
+
+  // Count the timer period that just ended
+  FORCE_INLINE void layer_stats_period(unsigned short period) {
+    #if LASER_CONTROL == 3
+      if (OCR4A) layer_stats.laser_on_ticks += period;
+    #else
+      if (laser.firing) layer_stats.laser_on_ticks += period;
+    #endif
+  }
+
+  // Count the block that's starting
+  FORCE_INLINE void layer_stats_block() {
+    layer_started = true;
+    layer_stats.blocks++;
+    if (current_block->laser_status == LASER_ON
+      #ifdef LASER_RASTER
+        || current_block->raster
+      #endif
+    )
+      layer_stats.marked_mm += current_block->millimeters;
+    else if (current_block->steps[X_AXIS] || current_block->steps[Y_AXIS])
+      layer_stats.jump_mm += current_block->millimeters;
+  }
+
+  // The block that's starting begins a layer: close the counts of the one before
+  FORCE_INLINE void layer_stats_next() {
+    last_layer_stats = layer_stats;
+    laser.time_counter += layer_stats.laser_on_ticks;
+    last_layer_number = layer_number;
+    layer_number = layer_marker_numbers[layer_markers_tail & (LAYER_MARKERS - 1)];
+    layer_markers_tail++;
+    memset(&layer_stats, 0, sizeof(layer_stats));
+    layer_started = false;
+  }
+
+  void layer_stats_get(layer_stats_t &stats, int &layer) {
+    CRITICAL_SECTION_START;
+    stats = layer_stats;
+    layer = layer_number;
+    CRITICAL_SECTION_END;
+  }
+
+  void layer_stats_last(layer_stats_t &stats, int &layer) {
+    CRITICAL_SECTION_START;
+    stats = last_layer_stats;
+    layer = last_layer_number;
+    CRITICAL_SECTION_END;
+  }
+
+  void layer_stats_marker(int layer) {
+    // Two markers with no block between them start the same block, so the
+    // later number wins
+    if (layer_start_pending) {
+      layer_marker_numbers[(layer_markers_head - 1) & (LAYER_MARKERS - 1)] = layer;
+      return;
+    }
+    while ((uint8_t)(layer_markers_head - layer_markers_tail) >= LAYER_MARKERS) idle();
+    layer_marker_numbers[layer_markers_head & (LAYER_MARKERS - 1)] = layer;
+    layer_markers_head++;
+    layer_start_pending = true;
+  }
+
+#endif // LASER_LAYER_STATS
+
+#ifdef GALVO_TIMED_MOTION
+
+  // Initializes the timed galvo updater from the current block
+  FORCE_INLINE void galvo_timed_reset() {
+    galvo_update_count = 0;
+    galvo_velocity[X_AXIS] = current_block->galvo_rate[X_AXIS];
+    galvo_velocity[Y_AXIS] = current_block->galvo_rate[Y_AXIS];
+    // Rounded as the start is, so an axis that doesn't move has nowhere to go
+    galvo_dac_end[X_AXIS] = ((unsigned long)current_block->x_dac << 16) | 0x8000;
+    galvo_dac_end[Y_AXIS] = ((unsigned long)current_block->y_dac << 16) | 0x8000;
+    #if defined(LASER_RASTER) || defined(LASER_PULSED) || defined(LASER_VELOCITY_POWER)
+      travel_axis = current_block->steps[X_AXIS] >= current_block->steps[Y_AXIS] ? X_AXIS : Y_AXIS;
+      travel_origin = galvo_dac[travel_axis];
+    #endif
+    #ifdef LASER_PULSED
+      laser_pulses = 0;
+    #endif
+    OCR1A = GALVO_UPDATE_TICKS;
+  }
+
+  // Moves one galvo by its current velocity without passing the end of the block.
+  // A velocity against the direction of travel (ramp round-off) holds the galvo.
+  // The end is compared before the distance to it is taken, as an unsigned
+  // distance from a galvo already at or past the end would wrap the DAC.
+  FORCE_INLINE void galvo_integrate(uint8_t axis) {
+    long v = galvo_velocity[axis];
+    if (TEST(out_bits, axis)) {
+      if (v < 0) {
+        if (galvo_dac[axis] <= galvo_dac_end[axis] || (unsigned long)-v >= galvo_dac[axis] - galvo_dac_end[axis])
+          galvo_dac[axis] = galvo_dac_end[axis];
+        else
+          galvo_dac[axis] += v;
+      }
+    }
+    else if (v > 0) {
+      if (galvo_dac[axis] >= galvo_dac_end[axis] || (unsigned long)v >= galvo_dac_end[axis] - galvo_dac[axis])
+        galvo_dac[axis] = galvo_dac_end[axis];
+      else
+        galvo_dac[axis] += v;
+    }
+  }
+
+  // Moves the galvos one update along the current block.
+  // Returns true once the block is complete.
+  FORCE_INLINE bool galvo_timed_update() {
+    if (galvo_update_count < current_block->galvo_accel_until) {
+      galvo_velocity[X_AXIS] += current_block->galvo_accel[X_AXIS];
+      galvo_velocity[Y_AXIS] += current_block->galvo_accel[Y_AXIS];
+    }
+    else if (galvo_update_count >= current_block->galvo_decel_after) {
+      galvo_velocity[X_AXIS] -= current_block->galvo_accel[X_AXIS];
+      galvo_velocity[Y_AXIS] -= current_block->galvo_accel[Y_AXIS];
+    }
+
+    bool done = ++galvo_update_count >= current_block->galvo_updates;
+    if (done) {
+      // Land exactly on the end of the block, whatever the ramp round-off
+      galvo_dac[X_AXIS] = galvo_dac_end[X_AXIS];
+      galvo_dac[Y_AXIS] = galvo_dac_end[Y_AXIS];
+    }
+    else {
+      galvo_integrate(X_AXIS);
+      galvo_integrate(Y_AXIS);
+    }
+
+    galvo_output(current_block->steps[X_AXIS], current_block->steps[Y_AXIS],
+                 galvo_dac[X_AXIS] >> 16, galvo_dac[Y_AXIS] >> 16);
+
+    #ifdef LASER_RASTER
+      if (current_block->raster) {
+        if (done) raster_done(); else raster_update();
+      }
+    #endif
+
+    #ifdef LASER_PULSED
+      if (current_block->laser_status == LASER_ON) laser_pulse_update(done);
+    #endif
+
+    #ifdef LASER_VELOCITY_POWER
+      laser_power_update();
+    #endif
+
+    if (done) galvo_block_counted();
+    return done;
+  }
+
+#endif // GALVO_TIMED_MOTION
+
 // Initializes the trapezoid generator from the current block. Called whenever a new
 // block begins.
 FORCE_INLINE void trapezoid_generator_reset() {
@@ -429,7 +839,40 @@ FORCE_INLINE void trapezoid_generator_reset() {
     out_bits = current_block->direction_bits;
     set_stepper_direction();
   }
-  
+
+  #ifdef LASER
+    // Start from the planner's DAC word, rounded to the nearest DAC step
+    galvo_dac[X_AXIS] = ((unsigned long)current_block->x_dac_current << 16) | 0x8000;
+    galvo_dac[Y_AXIS] = ((unsigned long)current_block->y_dac_current << 16) | 0x8000;
+  #endif
+
+  #ifdef LASER_PULSED
+    // The first pulse of a mark comes at its start
+    if (current_block->laser_status != LASER_ON) laser_pulse_phase = 0xFFFF;
+  #endif
+
+  #ifdef PLANNER_DWELL
+    if (current_block->dwell) {
+      galvo_update_count = 0; // Counts milliseconds
+      OCR1A = 2000;
+      return;
+    }
+  #endif
+
+  #ifdef GALVO_JUMP_MODE
+    if (current_block->galvo_jump) {
+      galvo_settling = false; // The jump itself is made by the interrupt
+      return;
+    }
+  #endif
+
+  #ifdef GALVO_TIMED_MOTION
+    if (current_block->galvo_timed) {
+      galvo_timed_reset();
+      return;
+    }
+  #endif
+
   #ifdef ADVANCE
     advance = current_block->initial_advance;
     final_advance = current_block->final_advance;
@@ -461,8 +904,27 @@ FORCE_INLINE void trapezoid_generator_reset() {
 // It pops blocks from the block_buffer and executes them by pulsing the stepper pins appropriately.
 ISR(TIMER1_COMPA_vect) {
 	WRITE(STEP_TRIGGER, HIGH);  //Debug pin in order to see ISR timing
+  #ifdef LASER_DELAYS
+    laser_on_period(OCR1A); // OCR1A still holds the period that just ended
+  #endif
+  #ifdef LASER_PULSED
+    laser_pulse_period(OCR1A);
+  #endif
+  #ifdef LASER_LAYER_STATS
+    layer_stats_period(OCR1A);
+  #endif
   if (cleaning_buffer_counter)
   {
+    #ifdef LASER_DELAYS
+      laser_on_cancel();
+      laser_dwelling = false;
+    #endif
+    #ifdef LASER_PULSED
+      if (laser_pulse_on) laser_pulse_end();
+    #endif
+    #ifdef LASER_VELOCITY_POWER
+      OCR4A = 0;
+    #endif
     current_block = NULL;
     plan_discard_current_block();
     #ifdef SD_FINISHED_RELEASECOMMAND
@@ -479,7 +941,14 @@ ISR(TIMER1_COMPA_vect) {
     current_block = plan_get_current_block();
     if (current_block) {
       current_block->busy = true;
+      #ifdef LASER_LAYER_STATS
+        if (current_block->layer_start) layer_stats_next();
+        layer_stats_block();
+      #endif
       trapezoid_generator_reset();
+      #ifdef LASER_VELOCITY_POWER
+        laser_power_start();
+      #endif
       counter_x = -(current_block->step_event_count >> 1);
       counter_y = counter_z = counter_e = counter_x;
       step_events_completed = 0;
@@ -492,20 +961,50 @@ ISR(TIMER1_COMPA_vect) {
         }
       #endif
 
+      #ifdef LASER_DELAYS
+        if (current_block->laser_dwell_ticks) {
+          // Leave the laser as it is for the off or polygon delay
+          laser_dwelling = true;
+          OCR1A = current_block->laser_dwell_ticks;
+          WRITE(STEP_TRIGGER, LOW);
+          return;
+        }
+        laser_block_start();
+      #endif
+
       // #ifdef ADVANCE
       //   e_steps[current_block->active_extruder] = 0;
       // #endif
     }
     else {
       OCR1A = 2000; // 1kHz.
+      #ifdef LASER_LAYER_STATS
+        if (layer_started) layer_stats.starved_ticks += 2000;
+      #endif
+      #ifdef LASER_VELOCITY_POWER
+        OCR4A = 0; // Nothing to mark
+      #endif
     }
   }
 
   if (current_block != NULL) {
-#if defined(LASER) && LASER_CONTROL == 1
+#ifdef LASER_DELAYS
+    if (laser_dwelling) {
+      // Delay over. Switch the laser and start the block.
+      laser_dwelling = false;
+      laser_block_start();
+      #ifdef GALVO_TIMED_MOTION
+        if (current_block->galvo_timed) OCR1A = GALVO_UPDATE_TICKS;
+      #endif
+    }
+#elif defined(LASER) && LASER_CONTROL == 1
 	  // Laser - Continuous Firing Mode
 
-	  if (current_block->laser_status == LASER_ON) {
+	  if (current_block->laser_status == LASER_ON
+#ifdef LASER_PULSED
+	      && !current_block->galvo_timed // Galvo marks are pulsed
+#endif
+	  ) {
 #ifdef INVERT_LASER
 		  WRITE(LASER_FIRING_PIN, LOW);
 #else 
@@ -515,7 +1014,14 @@ ISR(TIMER1_COMPA_vect) {
 		  laser.firing = LASER_ON;
 	  }
 
+#ifdef LASER_RASTER
+	  if (!current_block->raster) // Raster blocks set the laser per pixel
+#endif
 	  if (current_block->laser_status == LASER_OFF) {
+#ifdef LASER_PULSED
+		  DISABLE_LASER_PULSE_INTERRUPT();
+		  laser_pulse_on = false;
+#endif
 #ifdef INVERT_LASER
 		  WRITE(LASER_FIRING_PIN, HIGH);
 #else 
@@ -525,6 +1031,51 @@ ISR(TIMER1_COMPA_vect) {
 		  laser.firing = LASER_OFF;
 	  }
 #endif
+    #ifdef PLANNER_DWELL
+      if (current_block->dwell) {
+        if (galvo_update_count++ >= current_block->galvo_updates) {
+          current_block = NULL;
+          plan_discard_current_block();
+          OCR1A = 200; // Pick up the next block promptly
+        }
+        else
+          OCR1A = 2000; // 1ms
+        WRITE(STEP_TRIGGER, LOW);
+        return;
+      }
+    #endif
+
+    #ifdef GALVO_JUMP_MODE
+      if (current_block->galvo_jump) {
+        if (!galvo_settling) {
+          // Jump to the end of the block and come back when the mirrors have settled
+          galvo_output(current_block->steps[X_AXIS], current_block->steps[Y_AXIS], current_block->x_dac, current_block->y_dac);
+          galvo_settling = true;
+          OCR1A = current_block->galvo_jump_ticks;
+        }
+        else {
+          galvo_block_counted();
+          current_block = NULL;
+          plan_discard_current_block();
+          OCR1A = 200; // Pick up the next block promptly
+        }
+        WRITE(STEP_TRIGGER, LOW);
+        return;
+      }
+    #endif
+
+    #ifdef GALVO_TIMED_MOTION
+      // Galvo-only blocks have no endstops or steppers to service
+      if (current_block->galvo_timed) {
+        if (galvo_timed_update()) {
+          current_block = NULL;
+          plan_discard_current_block();
+        }
+        WRITE(STEP_TRIGGER, LOW);
+        return;
+      }
+    #endif
+
     // Check endstops
     if (check_endstops) {
       
@@ -690,8 +1241,6 @@ ISR(TIMER1_COMPA_vect) {
 #define _COUNTER(axis) counter_## axis
 #define _APPLY_STEP(AXIS) AXIS ##_APPLY_STEP
 #define _GALVO_POS(AXIS) AXIS ##_Galvo_Position
-#define _SPI_TRANSFER asm volatile("nop"); \
-						while (!(SPSR & _BV(SPIF)));
 	/*
 #define APPLY_GALVO_MOVEMENT(axis, AXIS) \
 		  _COUNTER(axis) += current_block->steps[_AXIS(AXIS)] << step_shift; \
@@ -702,42 +1251,30 @@ ISR(TIMER1_COMPA_vect) {
 		  }
 
 		  */
-	// unrolled the SPI transfer function in order to save on function calls.
-	// current bit shifts are for a 4096 grid.  Will need to update this 
-	// for a dynamic grid system
+	// the DAC write is inlined from galvo_dac.h in order to save on function calls.
+	// The planner has already scaled and clamped the block into DAC units, so
+	// each galvo step is a single add of the block's DAC increment.
 
 #define APPLY_GALVO_MOVEMENT(axis, AXIS) \
+          bool axis ##_moved = false; \
           _COUNTER(axis) += current_block->steps[_AXIS(AXIS)]; \
           if (_COUNTER(axis) > 0) { \
             _COUNTER(axis) -= current_block->step_event_count; \
             count_position[_AXIS(AXIS)] += count_direction[_AXIS(AXIS)]; \
-			_GALVO_POS(AXIS) += count_direction[_AXIS(AXIS)]; \
-			if (_GALVO_POS(AXIS) > GRID_SIZE) { \
-				_GALVO_POS(AXIS) = GRID_SIZE; \
-										} \
-			WRITE(GALVO_SS_PIN, LOW); \
-			SPDR = AXIS ##_AXIS | (3 << 4); \
-			_SPI_TRANSFER \
-			scaled_value = _GALVO_POS(AXIS) << 5 ;\
-			SPDR = scaled_value >> 8; \
-			_SPI_TRANSFER \
-			SPDR = scaled_value; \
-			_SPI_TRANSFER \
-			WRITE(GALVO_SS_PIN, HIGH); \
+			galvo_dac[_AXIS(AXIS)] += current_block->axis ##_dac_step; \
+			axis ##_moved = true; \
 		  }
 		  
 	APPLY_GALVO_MOVEMENT(x, X);
 	APPLY_GALVO_MOVEMENT(y, Y);
+	// Both galvos go out together, once per tick
+	galvo_output(x_moved, y_moved, galvo_dac[X_AXIS] >> 16, galvo_dac[Y_AXIS] >> 16);
 	
 #endif
 
 
     // Take multiple steps per interrupt (For high speed moves)
     for (int8_t i = 0; i < step_loops; i++) {
-      #ifndef AT90USB
-        MSerial.checkRx(); // Check for serial chars.
-      #endif
-
       #ifdef ADVANCE
         counter_e += current_block->steps[E_AXIS];
         if (counter_e > 0) {
@@ -845,6 +1382,9 @@ ISR(TIMER1_COMPA_vect) {
 
     // If current block is finished, reset pointer
     if (step_events_completed >= current_block->step_event_count) {
+      #ifdef LASER
+        galvo_block_done();
+      #endif
       current_block = NULL;
       plan_discard_current_block();
     }
@@ -1201,6 +1741,9 @@ void quickStop() {
   DISABLE_STEPPER_DRIVER_INTERRUPT();
   while (blocks_queued()) plan_discard_current_block();
   current_block = NULL;
+  #ifdef LASER_RASTER
+    raster_buffer_tail = raster_buffer_head; // Drop the pixels of the discarded blocks
+  #endif
   ENABLE_STEPPER_DRIVER_INTERRUPT();
 }
 
@@ -1286,18 +1829,11 @@ void quickStop() {
 
   FORCE_INLINE void move_galvo(unsigned int axis, unsigned short value)
   {
-	  /*
-	  offset_value = (int) value - grid;
-	  sign = offset_value < 0 ? -1 : 1;
-	  scaled_value = (int) pgm_read_word_near(dac_table + abs(offset_value)) * sign + 32767;
-	  */
 	  scaled_value = value << 4;
-	  //relocated galvo transfer here to save a function call
-	  WRITE(GALVO_SS_PIN, LOW);
-	  SPI.transfer((axis | (3 << 4)));  // Sets the axis and update immediately
-	  SPI.transfer((uint8_t)((unsigned short) scaled_value >> 8));
-	  SPI.transfer((uint8_t)(unsigned short) scaled_value);  // Sends position
-	  WRITE(GALVO_SS_PIN, HIGH);
+	  // Shares the DAC output stage with the stepper interrupt
+	  CRITICAL_SECTION_START;
+	  galvo_dac_move(axis, scaled_value);
+	  CRITICAL_SECTION_END;
   }
 
   void move_galvos(unsigned long X, unsigned long Y)
@@ -1314,8 +1850,10 @@ void quickStop() {
 	  {
 		  sY = GRID_SIZE;
 	  }
-	  move_galvo(X_AXIS, sX);
-	  move_galvo(Y_AXIS, sY);
+	  // Shares the DAC output stage with the stepper interrupt
+	  CRITICAL_SECTION_START;
+	  galvo_dac_move_xy(sX << 4, sY << 4);
+	  CRITICAL_SECTION_END;
   }
 
   void X_galvo_step(int step_dir)
@@ -121,5 +121,23 @@ void microstep_readings();
 #ifdef BABYSTEPPING
   void babystep(const uint8_t axis,const bool direction); // perform a short step with a single stepper motor, outside of any convention
 #endif
+
+#ifdef LASER_LAYER_STATS
+  // What the stepper did over a layer. Laser-on time is counted in whole timer periods.
+  typedef struct {
+    unsigned long laser_on_ticks;  // Timer1 ticks with the laser on
+    unsigned long starved_ticks;   // Timer1 ticks with no block to run, once the layer had started
+    unsigned long blocks;          // Blocks run
+    float marked_mm;               // mm moved with the laser on
+    float jump_mm;                 // mm moved with the laser off
+  } layer_stats_t;
+
+  void layer_stats_get(layer_stats_t &stats, int &layer);   // The layer in progress so far
+  void layer_stats_last(layer_stats_t &stats, int &layer);  // The last layer finished, -1 if none
+
+  // Start layer number layer at the next block planned. The stepper closes
+  // the counts of the layer before when it gets there, so nothing waits.
+  void layer_stats_marker(int layer);
+#endif
      
 #endif